@@ -0,0 +1,74 @@
+//
+//  check-cost-cache.cc
+//  easylocal
+//
+//  Checks the validity tracking of the cost caches, inline and on the heap, and the single computation of atomic slots.
+//
+
+#include <cost-cache.hh>
+#include "check.hh"
+
+#include <vector>
+#include <thread>
+#include <atomic>
+
+template <class Cache>
+void CheckCache(size_t components)
+{
+  Cache cache(components);
+  CHECK(cache.size() == components);
+  for (size_t i = 0; i < components; ++i)
+    CHECK(!cache.IsValid(i));
+  CHECK(!cache.AllValid());
+  cache.Set(components - 1, 7);
+  CHECK(cache.IsValid(components - 1) && cache.Get(components - 1) == 7);
+  CHECK(!cache.IsValid(0));
+  int fills = 0;
+  for (size_t i = 0; i < components; ++i)
+    CHECK(cache.GetOrCompute(i, [&cache, &fills, i]() { ++fills; cache.Set(i, int(i) * 2); }) == (i == components - 1 ? 7 : int(i) * 2));
+  CHECK(fills == int(components) - 1);
+  CHECK(cache.AllValid());
+  // copies keep the valid values and are independent of the original
+  Cache copy = cache;
+  copy.Invalidate(0);
+  CHECK(!copy.IsValid(0) && cache.IsValid(0));
+  copy.Set(1, -1);
+  CHECK(copy.Get(1) == -1 && cache.Get(1) == 2);
+  cache = copy;
+  CHECK(!cache.IsValid(0) && cache.Get(1) == -1 && cache.Get(components - 1) == 7);
+}
+
+int main()
+{
+  // within the inline capacity, across a mask word on the heap
+  CheckCache<easylocal::CostCache<int, 8>>(3);
+  CheckCache<easylocal::CostCache<int, 8>>(70);
+  CheckCache<easylocal::AtomicCostCache<int>>(5);
+
+  // a slot claimed by several threads is computed once
+  easylocal::AtomicCostCache<int> shared(4);
+  std::atomic<int> fills{ 0 };
+  std::vector<std::thread> threads;
+  std::vector<int> results(8, 0);
+  for (int t = 0; t < 8; ++t)
+    threads.emplace_back([&shared, &fills, &results, t]() {
+      results[t] = shared.GetOrCompute(2, [&shared, &fills]() { ++fills; shared.Set(2, 42); });
+    });
+  for (auto& thread : threads)
+    thread.join();
+  CHECK(fills == 1);
+  for (int r : results)
+    CHECK(r == 42);
+
+  // epoch-stamped values are computed again in a different epoch
+  easylocal::CachedValue<int> value;
+  int computations = 0;
+  CHECK(!value.IsValid());
+  CHECK(value.GetOrCompute(0, [&computations]() { return ++computations; }) == 1);
+  CHECK(value.GetOrCompute(0, [&computations]() { return ++computations; }) == 1);
+  CHECK(value.GetOrCompute(1, [&computations]() { return ++computations; }) == 2);
+  value.Invalidate();
+  CHECK(!value.IsValid(1));
+
+  return CheckResult("cost cache");
+}
@@ -0,0 +1,72 @@
+//
+//  check-hypervolume.cc
+//  easylocal
+//
+//  Checks the hypervolume indicator against fronts computed by hand.
+//
+
+#include <hypervolume.hh>
+#include "check.hh"
+
+#include <vector>
+
+int main()
+{
+  // two objectives, reference (10, 10): the front (2, 6), (4, 4), (7, 1) covers the slabs [2, 4) x 4, [4, 7) x 6 and
+  // [7, 10) x 9 of the box
+  easylocal::HypervolumeIndicator<int> h2({10, 10});
+  CHECK(h2.IsExact());
+  CHECK(h2.Value() == 0.0);
+  h2.Add({4, 4});
+  CHECK(h2.Value() == 36.0);
+  h2.Add({7, 1});
+  h2.Add({2, 6});
+  CHECK(h2.Value() == 2 * 4 + 3 * 6 + 3 * 9);
+  // dominated, duplicated and out of the box points leave it unchanged
+  h2.Add({5, 5});
+  h2.Add({4, 4});
+  h2.Add({1, 10});
+  h2.Add({12, 0});
+  CHECK(h2.Value() == 53.0);
+  // a point dominating (2, 6) and (4, 4) replaces them
+  h2.Add({1, 3});
+  CHECK(h2.Value() == 6 * 7 + 3 * 9);
+  h2.Reset();
+  CHECK(h2.Value() == 0.0);
+  h2.Add({4, 4});
+  CHECK(h2.Value() == 36.0);
+
+  // three objectives, reference (10, 10, 10): the boxes of (5, 5, 5) and (2, 8, 8) overlap in the box of (5, 8, 8)
+  easylocal::HypervolumeIndicator<int> h3({10, 10, 10});
+  CHECK(h3.IsExact());
+  h3.Add({5, 5, 5});
+  CHECK(h3.Value() == 125.0);
+  h3.Add({6, 6, 6});
+  h3.Add({2, 8, 8});
+  CHECK(h3.Value() == 125 + 8 * 2 * 2 - 5 * 2 * 2);
+  // (8, 2, 8) adds its own box minus the overlaps with (5, 5, 5) and (2, 8, 8), which in turn share (8, 8, 8)
+  h3.Add({8, 2, 8});
+  CHECK(h3.Value() == 137 + 2 * 8 * 2 - 2 * 5 * 2 - 2 * 2 * 2 + 2 * 2 * 2);
+  h3.Add({0, 0, 0});
+  CHECK(h3.Value() == 1000.0);
+
+  // four objectives, the value is estimated by sampling the box between the lower bound and the reference
+  easylocal::HypervolumeIndicator<short> h4(std::vector<short>(4, 10), {}, 100000, 1);
+  CHECK(!h4.IsExact());
+  h4.Add({5, 5, 5, 5});
+  double single = h4.Value();
+  CHECK_NEAR(single, 625, 50);
+  h4.Add({6, 6, 6, 6});
+  h4.Add({2, 8, 8, 8});
+  CHECK_NEAR(h4.Value(), 625 + 8 * 2 * 2 * 2 - 5 * 2 * 2 * 2, 50);
+  CHECK(h4.Value() >= single);
+  // the lower bound dominates every sample
+  h4.Add({0, 0, 0, 0});
+  CHECK(h4.Value() == 10000.0);
+  // the samples are kept by Reset, hence the estimate is the same
+  h4.Reset();
+  h4.Add({5, 5, 5, 5});
+  CHECK(h4.Value() == single);
+
+  return CheckResult("hypervolume");
+}
@@ -0,0 +1,129 @@
+//
+//  check-pareto-archive.cc
+//  easylocal
+//
+//  Checks insertions, dominance and duplicates in the Pareto archive.
+//
+
+#include <pareto-archive.hh>
+#include "check.hh"
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <functional>
+
+struct Label
+{
+  int id;
+  bool operator==(const Label& other) const = default;
+};
+
+template <>
+struct std::hash<Label>
+{
+  size_t operator()(const Label& l) const noexcept
+  {
+    return std::hash<int>{}(l.id);
+  }
+};
+
+// the archive only needs the values and the solution of a solution value
+struct LabelValue
+{
+  using Solution = Label;
+  using T = int;
+
+  LabelValue(int id, std::vector<int> values) : solution(std::make_shared<const Label>(Label{id})), values(std::move(values)) {}
+
+  std::vector<int> GetValues() const
+  {
+    return values;
+  }
+
+  std::shared_ptr<const Label> GetSolution() const
+  {
+    return solution;
+  }
+
+  std::shared_ptr<const Label> solution;
+  std::vector<int> values;
+};
+
+template <class Archive>
+std::vector<int> Ids(const Archive& archive)
+{
+  std::vector<int> ids;
+  for (const auto& sv : archive.Front())
+    ids.push_back(sv.GetSolution()->id);
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+// the same sequence is checked on bi-objective archives (sorted on the first objective) and on three-objective ones
+// (ND-tree, with small leaves so that they are split), the third objective being constant
+void CheckArchive(size_t objectives, size_t max_leaf_size)
+{
+  auto value = [objectives](int id, int f1, int f2) {
+    std::vector<int> values{f1, f2};
+    if (objectives == 3)
+      values.push_back(0);
+    return LabelValue(id, values);
+  };
+  easylocal::ParetoArchive<LabelValue> archive({}, max_leaf_size);
+  CHECK(archive.empty());
+  CHECK(archive.Insert(value(1, 2, 8)));
+  CHECK(archive.Insert(value(2, 5, 5)));
+  CHECK(archive.Insert(value(3, 8, 2)));
+  CHECK(archive.size() == 3);
+  // dominated values are rejected
+  CHECK(archive.IsDominated(value(4, 6, 6)));
+  CHECK(!archive.Insert(value(4, 6, 6)));
+  CHECK(!archive.Insert(value(5, 2, 9)));
+  // the same solution with the same values is stored once, a different solution with the same values is kept
+  CHECK(!archive.Insert(value(2, 5, 5)));
+  CHECK(!archive.IsDominated(value(6, 5, 5)));
+  CHECK(archive.Insert(value(6, 5, 5)));
+  CHECK(archive.size() == 4);
+  // a value dominating some archived ones drops them
+  CHECK(archive.Insert(value(7, 4, 4)));
+  CHECK((Ids(archive) == std::vector<int>{1, 3, 7}));
+  CHECK(archive.Insert(value(8, 1, 1)));
+  CHECK((Ids(archive) == std::vector<int>{8}));
+  // many mutually non-dominated values
+  archive.clear();
+  for (int i = 0; i < 50; ++i)
+    CHECK(archive.Insert(value(i, i, 100 - i)));
+  CHECK(archive.size() == 50);
+  CHECK(archive.IsDominated(value(100, 10, 91)));
+  CHECK(archive.Insert(value(100, 10, 89)));
+  // (10, 89) replaces (10, 90) and (11, 89), which it dominates
+  CHECK(archive.size() == 49);
+  CHECK(archive.Insert(value(101, 0, 0)));
+  CHECK(archive.size() == 1);
+}
+
+int main()
+{
+  CheckArchive(2, 20);
+  CheckArchive(3, 4);
+
+  // an epsilon bounds the archive: values within epsilon of being dominated are rejected
+  easylocal::ParetoArchive<LabelValue> bounded({1, 1});
+  CHECK(bounded.Insert(LabelValue(1, {5, 5})));
+  CHECK(!bounded.Insert(LabelValue(2, {4, 6})));
+  CHECK(bounded.Insert(LabelValue(3, {3, 7})));
+  CHECK(bounded.size() == 2);
+
+  // the tracked hypervolume follows the insertions
+  easylocal::ParetoArchive<LabelValue> tracked;
+  tracked.Insert(LabelValue(1, {4, 4}));
+  tracked.TrackHypervolume({10, 10});
+  CHECK(tracked.Hypervolume() == 36.0);
+  tracked.Insert(LabelValue(2, {2, 6}));
+  tracked.Insert(LabelValue(3, {7, 1}));
+  tracked.Insert(LabelValue(4, {5, 5}));
+  CHECK(tracked.Hypervolume() == 53.0);
+
+  return CheckResult("pareto archive");
+}
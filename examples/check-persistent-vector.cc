@@ -0,0 +1,78 @@
+//
+//  check-persistent-vector.cc
+//  easylocal
+//
+//  Checks that copies of a persistent vector share their chunks and are copied on write.
+//
+
+#include <persistent-vector.hh>
+#include "check.hh"
+
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <iterator>
+
+int main()
+{
+  static_assert(std::random_access_iterator<easylocal::PersistentVector<int>::const_iterator>);
+
+  // 10 chunks of 4 elements
+  easylocal::PersistentVector<int, 4> v;
+  for (int i = 0; i < 40; ++i)
+    v.push_back(i);
+  CHECK(v.size() == 40);
+  CHECK(v.front() == 0 && v.back() == 39);
+  CHECK(v.SharedChunks(v) == 10);
+
+  // a copy shares all the chunks until it is modified, then only the modified chunk is copied
+  auto w = v;
+  CHECK(w == v);
+  CHECK(w.SharedChunks(v) == 10);
+  w.Set(5, -5);
+  CHECK(w[5] == -5 && v[5] == 5);
+  CHECK(w.SharedChunks(v) == 9);
+  CHECK(w != v);
+  // further writes to the same chunk do not copy it again
+  w.Set(6, -6);
+  w.Mutable(7) = -7;
+  CHECK(w.SharedChunks(v) == 9);
+  w.Set(39, -39);
+  CHECK(w.SharedChunks(v) == 8);
+  for (int i = 0; i < 40; ++i)
+    CHECK(v[i] == i);
+
+  // writing to the original does not change the copy either
+  auto u = v;
+  v.Set(0, 100);
+  CHECK(u[0] == 0 && v[0] == 100);
+  CHECK(u.SharedChunks(v) == 9);
+  v.Set(0, 0);
+  // equal elements in different chunks
+  CHECK(u == v);
+
+  // growing and shrinking a copy
+  auto g = u;
+  g.push_back(40);
+  CHECK(g.size() == 41 && u.size() == 40);
+  CHECK(g.SharedChunks(u) == 10);
+  g.resize(36);
+  CHECK(g.size() == 36 && u.size() == 40 && u.back() == 39);
+  CHECK(g.SharedChunks(u) == 9);
+  g.clear();
+  CHECK(g.empty() && u.size() == 40);
+  CHECK(g.SharedChunks(u) == 0);
+
+  // iterators
+  std::vector<int> expected(40);
+  std::iota(expected.begin(), expected.end(), 0);
+  CHECK(std::equal(u.begin(), u.end(), expected.begin(), expected.end()));
+  CHECK(u.end() - u.begin() == 40);
+  CHECK(*(u.begin() + 17) == 17 && u.begin()[21] == 21 && *(u.end() - 1) == 39);
+  CHECK(std::lower_bound(u.begin(), u.end(), 23) - u.begin() == 23);
+
+  easylocal::PersistentVector<int> l{3, 1, 2};
+  CHECK(l.size() == 3 && l[0] == 3 && l[2] == 2);
+
+  return CheckResult("persistent vector");
+}
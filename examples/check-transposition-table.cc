@@ -0,0 +1,83 @@
+//
+//  check-transposition-table.cc
+//  easylocal
+//
+//  Checks hits, misses and replacements in the transposition table.
+//
+
+#include <transposition-table.hh>
+#include "check.hh"
+
+#include <array>
+#include <vector>
+#include <thread>
+#include <cstdint>
+
+int main()
+{
+  // the capacity is rounded up to a power of two buckets of two entries, 4 entries are two buckets: even hashes fall
+  // into the first one, odd hashes into the second one
+  easylocal::TranspositionTable<int> table(2, 3);
+  CHECK(table.Components() == 2);
+  CHECK(table.Capacity() == 4);
+  std::array<int, 2> values{};
+
+  // misses on an empty table
+  CHECK(!table.Load(0, values));
+  CHECK(!table.Load(1, values));
+  CHECK(table.Lookups() == 2 && table.Hits() == 0);
+
+  table.Store(0, std::array<int, 2>{0, 10});
+  table.Store(2, std::array<int, 2>{2, 12});
+  table.Store(1, std::array<int, 2>{1, 11});
+  CHECK(table.Load(0, values) && values == (std::array<int, 2>{0, 10}));
+  CHECK(table.Load(2, values) && values == (std::array<int, 2>{2, 12}));
+  CHECK(table.Load(1, values) && values == (std::array<int, 2>{1, 11}));
+  CHECK(!table.Load(3, values));
+  CHECK(table.Lookups() == 6 && table.Hits() == 3);
+
+  // 2 has been found last, hence storing 4 in the full bucket evicts 0
+  table.Store(4, std::array<int, 2>{4, 14});
+  CHECK(!table.Load(0, values));
+  CHECK(table.Load(2, values) && values == (std::array<int, 2>{2, 12}));
+  CHECK(table.Load(4, values) && values == (std::array<int, 2>{4, 14}));
+  // then 4 is the most recent one and 2 is evicted
+  table.Store(6, std::array<int, 2>{6, 16});
+  CHECK(!table.Load(2, values));
+  CHECK(table.Load(4, values) && table.Load(6, values));
+  // the other bucket is untouched
+  CHECK(table.Load(1, values) && values == (std::array<int, 2>{1, 11}));
+
+  // storing a hash again replaces its values without evicting the other entry of the bucket
+  table.Store(4, std::array<int, 2>{4, 24});
+  CHECK(table.Load(4, values) && values == (std::array<int, 2>{4, 24}));
+  CHECK(table.Load(6, values) && values == (std::array<int, 2>{6, 16}));
+
+  table.Clear();
+  CHECK(table.Lookups() == 0 && table.Hits() == 0);
+  CHECK(!table.Load(4, values) && !table.Load(6, values) && !table.Load(1, values));
+
+  // concurrent tables: the values found are the ones stored for the hash, even when entries are evicted meanwhile
+  easylocal::TranspositionTable<std::int64_t> shared(2, 256, true);
+  std::vector<std::thread> threads;
+  std::vector<int> wrong(4, 0);
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&shared, &wrong, t]() {
+      std::array<std::int64_t, 2> found{};
+      for (std::uint64_t i = 0; i < 20000; ++i)
+      {
+        std::uint64_t hash = (i * 7919 + t) % 1000;
+        if (shared.Load(hash, found))
+          wrong[t] += found[0] != std::int64_t(hash) || found[1] != -std::int64_t(hash);
+        else
+          shared.Store(hash, std::array<std::int64_t, 2>{std::int64_t(hash), -std::int64_t(hash)});
+      }
+    });
+  for (auto& thread : threads)
+    thread.join();
+  for (int t = 0; t < 4; ++t)
+    CHECK(wrong[t] == 0);
+  CHECK(shared.Hits() > 0 && shared.Hits() < shared.Lookups());
+
+  return CheckResult("transposition table");
+}
@@ -0,0 +1,32 @@
+//
+//  check.hh
+//  easylocal
+//
+//  Helpers of the self-checking example programs.
+//
+
+#pragma once
+
+#include <iostream>
+#include <cmath>
+
+// failed checks are counted and reported rather than asserted, so that they are run in release builds as well
+inline int failed_checks = 0;
+
+#define CHECK(condition)                                                                          \
+  do                                                                                              \
+  {                                                                                               \
+    if (!(condition))                                                                             \
+    {                                                                                             \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl;     \
+      ++failed_checks;                                                                            \
+    }                                                                                             \
+  } while (false)
+
+#define CHECK_NEAR(value, expected, tolerance) CHECK(std::abs(double(value) - double(expected)) <= (tolerance))
+
+inline int CheckResult(const char* name)
+{
+  std::cout << name << ": " << (failed_checks == 0 ? "passed" : "FAILED") << " (" << failed_checks << " failed checks)" << std::endl;
+  return failed_checks == 0 ? 0 : 1;
+}
@@ -12,6 +12,7 @@
 #include <neighborhood-explorer.hh>
 #include "multi-modal-neighborhood-explorer.hh"
 #include <plahc.hh>
+#include <persistent-vector.hh>
 
 #include <iostream>
 #include <memory>
@@ -32,7 +33,8 @@ class MySolution
 public:
   MySolution(std::shared_ptr<const MyInput> in) noexcept : in(in), v(in->n, 0) {}
   std::shared_ptr<const MyInput> in;
-  std::vector<int> v;
+  // copies of the solution (e.g., the neighbors materialized by the move values) share the chunks they do not modify
+  easylocal::PersistentVector<int> v;
 };
 
 // TODO: helper to transform a std::function (e.g., a lambda) in a CostComponent
@@ -70,8 +72,8 @@ public:
   {
     auto sol = std::make_shared<MySolution>(in);
     std::bernoulli_distribution dist(0.25);
-    for (auto& v : sol->v)
-      v = dist(rng);
+    for (size_t i = 0; i < sol->v.size(); ++i)
+      sol->v.Set(i, dist(rng));
     return sol;
   }
   
@@ -98,9 +100,9 @@ class EvenSetOneNeighborhoodExplorer : public easylocal::NeighborhoodExplorer<My
 public:
   EvenSetOneNeighborhoodExplorer(std::shared_ptr<const MySolutionManager> sm) noexcept : easylocal::NeighborhoodExplorer<MySolutionManager, EvenSetOne, EvenSetOneNeighborhoodExplorer>(sm) {}
 
-  easylocal::Generator<EvenSetOne> Neighborhood(std::shared_ptr<const MySolution> sol) const
+  easylocal::Generator<EvenSetOne> Neighborhood(const MySolution& sol) const
   {
-    for (size_t i = 0; i < sol->in->n; ++i)
+    for (size_t i = 0; i < sol.in->n; ++i)
     {
       for (int v = 0; v < 4; ++v)
         if (v % 2 == 0)
@@ -108,19 +110,19 @@ public:
     }
   }
 
-  EvenSetOne RandomMove(std::shared_ptr<const MySolution> sol) const
+  EvenSetOne RandomMove(const MySolution& sol) const
   {
     std::random_device dev;
     std::mt19937 rng(1234);
-    std::uniform_int_distribution<std::mt19937::result_type> dist_index(0, sol->in->n), dist_value(0, 4);
+    std::uniform_int_distribution<std::mt19937::result_type> dist_index(0, sol.in->n), dist_value(0, 4);
     auto v = dist_index(rng), x = dist_value(rng);
-    return EvenSetOne{v % 2 == 0 ? v : v + 1, int(x % 2 == 0 ? x : std::max<size_t>(x + 1, sol->in->n - 1))};
+    return EvenSetOne{v % 2 == 0 ? v : v + 1, int(x % 2 == 0 ? x : std::max<size_t>(x + 1, sol.in->n - 1))};
   }
 
-  void MakeMove(std::shared_ptr<MySolution> sol, const EvenSetOne& mv) const
+  void MakeMove(MySolution& sol, const EvenSetOne& mv) const
   {
-    assert(mv.index < sol->v.size());
-    sol->v[mv.index] = mv.value;
+    assert(mv.index < sol.v.size());
+    sol.v.Set(mv.index, mv.value);
   }    
 };
 
@@ -129,9 +131,9 @@ class OddSetOneNeighborhoodExplorer : public easylocal::NeighborhoodExplorer<MyS
 public:
   OddSetOneNeighborhoodExplorer(std::shared_ptr<const MySolutionManager> sm) noexcept : easylocal::NeighborhoodExplorer<MySolutionManager, OddSetOne, OddSetOneNeighborhoodExplorer>(sm) {}
 
-  easylocal::Generator<OddSetOne> Neighborhood(std::shared_ptr<const MySolution> sol) const
+  easylocal::Generator<OddSetOne> Neighborhood(const MySolution& sol) const
   {
-    for (size_t i = 0; i < sol->in->n; ++i)
+    for (size_t i = 0; i < sol.in->n; ++i)
     {
       for (int v = 0; v < 4; ++v)
         if (v % 2 == 1)
@@ -139,19 +141,19 @@ public:
     }
   }
 
-  OddSetOne RandomMove(std::shared_ptr<const MySolution> sol) const
+  OddSetOne RandomMove(const MySolution& sol) const
   {
     std::random_device dev;
     std::mt19937 rng(1234);
-    std::uniform_int_distribution<std::mt19937::result_type> dist_index(0, sol->in->n - 1), dist_value(0, 4);
+    std::uniform_int_distribution<std::mt19937::result_type> dist_index(0, sol.in->n - 1), dist_value(0, 4);
     auto v = dist_index(rng), x = dist_value(rng);
-    return OddSetOne{v % 2 == 1 ? v : v + 1, int(x % 2 == 1 ? x : std::max<size_t>(x + 1, sol->in->n - 1))};
+    return OddSetOne{v % 2 == 1 ? v : v + 1, int(x % 2 == 1 ? x : std::max<size_t>(x + 1, sol.in->n - 1))};
   }
 
-  void MakeMove(std::shared_ptr<MySolution> sol, const OddSetOne& mv) const
+  void MakeMove(MySolution& sol, const OddSetOne& mv) const
   {
-    assert(mv.index < sol->v.size());
-    sol->v[mv.index] = mv.value;
+    assert(mv.index < sol.v.size());
+    sol.v.Set(mv.index, mv.value);
   }
 };
 
@@ -180,25 +182,25 @@ class SetValueNeighborhoodExplorer : public easylocal::NeighborhoodExplorer<MySo
 public:
   SetValueNeighborhoodExplorer(std::shared_ptr<const MySolutionManager> sm) noexcept : easylocal::NeighborhoodExplorer<MySolutionManager, SetValue, SetValueNeighborhoodExplorer>(sm), rng(1234) {}
 
-  easylocal::Generator<SetValue> Neighborhood(std::shared_ptr<const MySolution> sol) const
+  easylocal::Generator<SetValue> Neighborhood(const MySolution& sol) const
   {
-    for (size_t i = 0; i < sol->in->n; ++i)
+    for (size_t i = 0; i < sol.in->n; ++i)
     {
       co_yield SetValue{i, 0};
     }
   }
 
-  SetValue RandomMove(std::shared_ptr<const MySolution> sol) const
+  SetValue RandomMove(const MySolution& sol) const
   {
-    std::uniform_int_distribution<std::mt19937::result_type> dist_index(0, sol->in->n - 1), dist_value(0, 4);
+    std::uniform_int_distribution<std::mt19937::result_type> dist_index(0, sol.in->n - 1), dist_value(0, 4);
     auto i = dist_index(rng);
     return SetValue{i, int(dist_value(rng))};
   }
 
-  void MakeMove(std::shared_ptr<MySolution> sol, const SetValue& mv) const
+  void MakeMove(MySolution& sol, const SetValue& mv) const
   {
-    assert(mv.index < sol->v.size());
-    sol->v[mv.index] = mv.value;
+    assert(mv.index < sol.v.size());
+    sol.v.Set(mv.index, mv.value);
   }
     
   mutable std::mt19937 rng;
@@ -252,6 +254,15 @@ int main(int argc, const char * argv[])
     DeltaZeroElements dze;
     s_ne->AddDeltaCostComponent(dze, 1);
   
+    // the neighbor materialized by a move value copies only the chunk of the solution modified by the move
+    static_assert(std::random_access_iterator<easylocal::PersistentVector<int>::const_iterator>);
+    auto large_sol = sm->InitialSolution(std::make_shared<MyInput>(1000));
+    auto sv = sm->CreateSolutionValue(large_sol);
+    auto neighbor = s_ne->CreateMoveValue(sv, SetValue{500, 3}).GetSolution();
+    assert(neighbor->v[500] == 3 && large_sol->v[500] != 3);
+    assert(neighbor->v.SharedChunks(large_sol->v) == (1000 + 63) / 64 - 1);
+    assert(std::count(neighbor->v.begin(), neighbor->v.end(), 0) == std::count(large_sol->v.begin(), large_sol->v.end(), 0) - (large_sol->v[500] == 0));
+  
 //  auto plahc = easylocal::PLAHC<MySolutionManager, SetValueNeighborhoodExplorer>(sm, s_ne, 10);
 //  plahc.Run(p_in);
   // FIXME: it will be removed later
@@ -275,13 +286,14 @@ int main(int argc, const char * argv[])
 
     u_ne.AddDeltaCostComponent<SetValue>(dze, 1);
     
-    auto mv = u_ne.RandomMove(sol);
+    auto mv = u_ne.RandomMove(*sol);
     
     auto has_it = u_ne.HasDeltaCostComponent(1, mv);
     if (has_it)
-        u_ne.ComputeDeltaCost(sol, mv, 1);
+        u_ne.ComputeDeltaCost(*sol, mv, 1);
     
-    u_ne.InverseMove(sol, mv, mv);
+    // the basic neighborhood explorers do not define Inverse, hence neither does the union
+//    u_ne.InverseMove(*sol, mv, mv);
 
 //
 ////  auto mv2 = u_ne.random(sol1);
@@ -37,17 +37,30 @@ template <class Runner>
 class FullNeighborhoodGenerator : public Parametrized
 {
     using MoveValue = typename Runner::MoveValue;
+    using Move = typename Runner::Move;
 public:
     easylocal::Generator<std::shared_ptr<MoveValue>> generate_moves(Runner* r)
     {
-        for (auto mv : r->ne->Neighborhood(r->current_solution_value->GetSolution()))
+        // moves are evaluated in chunks, so that batched delta cost components can be exploited
+        auto neighborhood = r->ne->Neighborhood(*r->current_solution_value->GetSolution());
+        auto it = neighborhood.begin();
+        while (it != std::default_sentinel)
         {
-            co_yield std::make_shared<MoveValue>(r->ne->CreateMoveValue(*(r->current_solution_value), mv));
+            moves.clear();
+            for (; it != std::default_sentinel && moves.size() < batch_size; ++it)
+                moves.push_back(*it);
+            r->ne->CreateMoveValues(*(r->current_solution_value), moves, move_values);
+            // each move gets its own move value, since the runner may keep the yielded pointer (e.g., as its current move)
+            for (const auto& move_value : move_values)
+                co_yield std::make_shared<MoveValue>(move_value);
         }
     }
     virtual void initialize()
     {}
 protected:
+    static constexpr size_t batch_size = 256;
+    std::vector<Move> moves;
+    std::vector<MoveValue> move_values;
 };
 
 // TODO: give a more meaningful name
@@ -109,10 +122,10 @@ protected:
         // worse_move_index
         size_t worse_move_index = 0;
         // worse_move
-        MoveValue worse_move_value = r->ne->CreateMoveValue(*(r->current_solution_value), r->ne->RandomMove(r->current_solution_value->GetSolution()));
+        MoveValue worse_move_value = r->ne->CreateMoveValue(*(r->current_solution_value), r->ne->RandomMove(*r->current_solution_value->GetSolution()));
         bool initialized = false;
         // for mv in neighborhood
-        for (auto mv : r->ne->Neighborhood(r->current_solution_value->GetSolution()))
+        for (auto mv : r->ne->Neighborhood(*r->current_solution_value->GetSolution()))
         {
             MoveValue current_move_value = r->ne->CreateMoveValue(*(r->current_solution_value), mv);
             // if candidate list size < k
@@ -134,8 +147,8 @@ protected:
             // else
             else
             {
-                // if better than worse, then put this in that place
-                if(current_move_value.AggregatedCost() < worse_move_value.AggregatedCost())
+                // if better than worse, then put this in that place (the bounded comparison discards most moves cheaply)
+                if(current_move_value.BoundedLess(worse_move_value))
                 {
                     elite_candidates[worse_move_index] = current_move_value;
                     // find the new worse
@@ -243,7 +256,7 @@ public:
         const auto& current_solution = r->current_move_value->GetSolution();
         for (const auto& tl_move : tabu_moves)
         {
-            if (r->ne->Inverse(current_solution, current_move, tl_move))
+            if (r->ne->Inverse(*current_solution, current_move, tl_move))
             {
 #if !defined(NDEBUG)
                 std::ostringstream oss;
@@ -341,7 +354,7 @@ public:
 #if !defined(NDEBUG)
         spdlog::debug("FixedLengthObjectiveBasedTabuList - retrieve least tabu move");
 #endif
-        return r->ne->RandomMove(r->current_solution_value->GetSolution());
+        return r->ne->RandomMove(*r->current_solution_value->GetSolution());
     }
 protected:
     std::vector<T> tabu_moves;
@@ -379,7 +392,7 @@ public:
         const auto& current_solution = r->current_move_value->GetSolution();
         for (const auto& tl_move : tabu_moves)
         {
-            if (r->ne->Inverse(current_solution, current_move, tl_move))
+            if (r->ne->Inverse(*current_solution, current_move, tl_move))
             {
                 return true;
             }
@@ -455,7 +468,7 @@ public:
         const auto& current_solution = r->current_move_value->GetSolution();
         for (const auto& tl_move : tabu_moves)
         {
-            if (r->ne->Inverse(current_solution, current_move, tl_move))
+            if (r->ne->Inverse(*current_solution, current_move, tl_move))
             {
                 return true;
             }
@@ -537,7 +550,7 @@ public:
         const auto& current_solution = r->current_move_value->GetSolution();
         for (const auto& tl_move : tabu_moves)
         {
-            if (r->ne->Inverse(current_solution, current_move, tl_move.first))
+            if (r->ne->Inverse(*current_solution, current_move, tl_move.first))
             {
 #if !defined(NDEBUG)
                 spdlog::debug("GendrauTabuList - move is tabu");
@@ -618,7 +631,7 @@ public:
         const auto& current_solution = r->current_move_value->GetSolution();
         for (const auto& tl_move : tabu_moves)
         {
-            if (r->ne->Inverse(current_solution, current_move, tl_move))
+            if (r->ne->Inverse(*current_solution, current_move, tl_move))
             {
 #if !defined(NDEBUG)
                 std::ostringstream oss;
@@ -759,7 +772,7 @@ public:
     {
         // return the move that has the lower measure
         // thing is in transition_measure_table, I am saving possibly just part of the move, not the entire move, so how can I go back?
-        return r->ne->RandomMove(r->current_solution_value->GetSolution());
+        return r->ne->RandomMove(*r->current_solution_value->GetSolution());
     }
 protected:
     std::map<size_t, size_t> transition_measure_table;
@@ -805,7 +818,7 @@ public:
         const auto& current_solution = r->current_move_value->GetSolution();
         for (const auto& tl_move : tabu_moves)
         {
-            if (r->ne->Inverse(current_solution, current_move, tl_move))
+            if (r->ne->Inverse(*current_solution, current_move, tl_move))
             {
 #if !defined(NDEBUG)
                 spdlog::debug("FooSchemeTabuList - move is tabu");
@@ -960,7 +973,7 @@ public:
         const auto& current_solution = r->current_move_value->GetSolution();
         for (const auto& tl_move : tabu_moves)
         {
-            if (r->ne->Inverse(current_solution, current_move, tl_move))
+            if (r->ne->Inverse(*current_solution, current_move, tl_move))
             {
 #if !defined(NDEBUG)
                 spdlog::debug("RandomFooSchemeTabuList - move is tabu");
@@ -1075,7 +1088,7 @@ class AspirationByObjective : public Parametrized
 public:
     bool is_tabu_status_overridden(Runner* r)
     {
-        if (*(r->current_move_value) < *(r->best_solution_value))
+        if (r->current_move_value->BoundedLess(*(r->best_solution_value)))
         {
 #if !defined(NDEBUG)
             spdlog::debug("AspirationByObjective - Tabu status overriden");
@@ -1141,7 +1154,7 @@ class StopExplorationFirstImprovement : public Parametrized
 public:
     bool has_to_stop(Runner* r)
     {
-        if (*(r->current_move_value) < *(r->best_solution_value))
+        if (r->current_move_value->BoundedLess(*(r->best_solution_value)))
         {
 #if !defined(NDEBUG)
             spdlog::debug("StopExplorationFirstImprovement - Stopping at best improvement");
@@ -1218,7 +1231,7 @@ class SelectMoveRandom : public Parametrized
 public:
     auto select(Runner* r)
     {
-        return r->ne->CreateMoveValue(*r->current_solution_value, r->ne->RandomMove(r->current_solution_value->GetSolution()));
+        return r->ne->CreateMoveValue(*r->current_solution_value, r->ne->RandomMove(*r->current_solution_value->GetSolution()));
     }
 protected:
 };
@@ -1232,19 +1245,33 @@ public:
     auto select(Runner* r)
     {
         bool best_move_value_initialized = false;
-        for (auto mv : r->ne->Neighborhood(r->current_solution_value->GetSolution()))
+        // moves are evaluated in chunks, so that batched delta cost components can be exploited
+        auto neighborhood = r->ne->Neighborhood(*r->current_solution_value->GetSolution());
+        auto it = neighborhood.begin();
+        while (it != std::default_sentinel)
         {
-            current_move_value = std::make_shared<MoveValue>(r->ne->CreateMoveValue(*(r->current_solution_value), mv));
-            if (!best_move_value_initialized || *current_move_value < *best_move_value)
+            moves.clear();
+            for (; it != std::default_sentinel && moves.size() < batch_size; ++it)
+                moves.push_back(*it);
+            r->ne->CreateMoveValues(*(r->current_solution_value), moves, move_values);
+            for (const auto& current_move_value : move_values)
             {
-                best_move_value = std::make_shared<MoveValue>(*current_move_value);
-                best_move_value_initialized = true;
+                if (!best_move_value_initialized || current_move_value.BoundedLess(*best_move_value))
+                {
+                    best_move_value = std::make_shared<MoveValue>(current_move_value);
+                    best_move_value_initialized = true;
+                }
             }
         }
+        if (!best_move_value_initialized)
+            throw EmptyNeighborhood();
         return *best_move_value;
     }
 protected:
-    std::shared_ptr<MoveValue> best_move_value, current_move_value;
+    static constexpr size_t batch_size = 256;
+    std::vector<Move> moves;
+    std::vector<MoveValue> move_values;
+    std::shared_ptr<MoveValue> best_move_value;
 };
 
 // TODO: define the proper concept for AcceptMove
@@ -1280,7 +1307,7 @@ class AcceptMoveImprove : public Parametrized
 public:
     bool accept(Runner* r)
     {
-        return *(r->current_move_value) < *(r->current_solution_value);
+        return r->current_move_value->BoundedLess(*(r->current_solution_value));
     }
 protected:
 };
@@ -27,6 +27,11 @@
 #include <type_traits>
 #include <string>
 #include <iostream>
+#include <memory>
+#include <vector>
+#include <span>
+#include <utility>
+#include <cstdint>
 #include "utils.hh"
 
 namespace easylocal {
@@ -37,11 +42,10 @@ namespace easylocal {
   template <typename Input>
   concept InputT = std::is_constructible_v<Input, std::string> || std::is_constructible_v<Input, std::istream> || std::is_constructible_v<Input, int>; 
 
+  // solutions are copied when moves are materialized, they are not required to refer to their input (e.g., through a
+  // std::shared_ptr<const Input> member, whose reference count would be updated by every copy)
   template <typename Solution, typename Input>
-  concept SolutionT = InputT<Input> && requires(Solution s) {
-    //check that the solution class has a shared pointer to a const input object
-  { s.in } -> std::same_as<std::shared_ptr<const Input>&>;
-  };
+  concept SolutionT = InputT<Input> && std::copy_constructible<Solution>;
 
   template <typename T>
   concept Printable = requires(std::ostream& os, const T& s) {
@@ -77,21 +81,66 @@ namespace easylocal {
 
   template <typename CostComponent, class Input, class Solution, typename T>
   concept CostComponentT = match_basic_classes<CostComponent, Input, Solution, T> && 
-  requires(CostComponent cc, std::shared_ptr<const Solution> sol) {
+  requires(CostComponent cc, const Solution& sol) {
     { cc.ComputeCost(sol) } -> std::same_as<T>;
   };
 
   template <typename DeltaCostComponent, class Input, class Solution, typename T, typename Move>
   concept DeltaCostComponentT = match_basic_classes<DeltaCostComponent, Input, Solution, T> && 
-  requires(DeltaCostComponent dcc, std::shared_ptr<const Solution> sol, const Move& mv) {
+  requires(DeltaCostComponent dcc, const Solution& sol, const Move& mv) {
     { dcc.ComputeDeltaCost(sol, mv) } -> std::same_as<T>;
       // TODO: check if still needed
 //    { dcc.Components() } -> std::same_as<size_t>;
   };
 
+  template <typename DeltaCostComponent, class Input, class Solution, typename T, typename Move>
+  concept BatchDeltaCostComponentT = DeltaCostComponentT<DeltaCostComponent, Input, Solution, T, Move> && 
+  requires(DeltaCostComponent dcc, const Solution& sol, std::span<const Move> mvs, std::span<T> deltas) {
+    { dcc.ComputeDeltaCosts(sol, mvs, deltas) } -> std::same_as<void>;
+  };
+
+  template <typename DeltaCostComponent, class Input, class Solution, typename T, typename Move>
+  concept BoundedDeltaCostComponentT = DeltaCostComponentT<DeltaCostComponent, Input, Solution, T, Move> && 
+  requires(DeltaCostComponent dcc, const Solution& sol, const Move& mv) {
+    { dcc.LowerBoundDelta(sol, mv) } -> std::same_as<T>;
+  };
+
+  template <typename DeltaCostComponent, class Input, class Solution, typename T, typename Move>
+  concept FilteredDeltaCostComponentT = DeltaCostComponentT<DeltaCostComponent, Input, Solution, T, Move> && 
+  requires(DeltaCostComponent dcc, const Solution& sol, const Move& mv) {
+    { dcc.Affects(sol, mv) } -> std::same_as<bool>;
+  };
+
+  template <typename CostComponent, class Input, class Solution, typename T>
+  concept StatefulCostComponentT = CostComponentT<CostComponent, Input, Solution, T> && 
+  requires() {
+    typename CostComponent::State;
+  } && std::copy_constructible<typename CostComponent::State> && std::constructible_from<typename CostComponent::State, const Solution&>;
+
+  template <typename DeltaCostComponent, class Input, class Solution, typename T, typename Move>
+  concept StatefulDeltaCostComponentT = DeltaCostComponentT<DeltaCostComponent, Input, Solution, T, Move> && 
+  requires(DeltaCostComponent dcc, const Solution& sol, typename DeltaCostComponent::State& st, const Move& mv) {
+    { dcc.ComputeDeltaCost(sol, std::as_const(st), mv) } -> std::same_as<T>;
+    { dcc.UpdateState(st, sol, mv) } -> std::same_as<void>;
+  };
+
+  template <typename FusedCostComponent, class Input, class Solution, typename T>
+  concept FusedCostComponentT = match_basic_classes<FusedCostComponent, Input, Solution, T> && 
+  requires(FusedCostComponent fcc, const Solution& sol, std::span<T> costs) {
+    { fcc.Components() } -> std::same_as<size_t>;
+    { fcc.ComputeCosts(sol, costs) } -> std::same_as<void>;
+  };
+
+  template <typename FusedDeltaCostComponent, class Input, class Solution, typename T, typename Move>
+  concept FusedDeltaCostComponentT = match_basic_classes<FusedDeltaCostComponent, Input, Solution, T> && 
+  requires(FusedDeltaCostComponent fdcc, const Solution& sol, const Move& mv, std::span<T> deltas) {
+    { fdcc.Components() } -> std::same_as<size_t>;
+    { fdcc.ComputeDeltaCosts(sol, mv, deltas) } -> std::same_as<void>;
+  };
+
   template <typename CostStructure, typename Input, typename Solution, typename T>
   concept CostStructureT = match_basic_typedefs<CostStructure, Input, Solution, T> && 
-  requires(CostStructure s, std::shared_ptr<const Solution> sol, size_t i)
+  requires(CostStructure s, const Solution& sol, size_t i)
   {
     { s.ComputeCost(sol, i) } -> std::same_as<T>;
     { s.Components() } -> std::same_as<size_t>;
@@ -99,7 +148,7 @@ namespace easylocal {
 
   template <typename CostStructure>
   concept CostStructureTd = has_basic_typedefs<CostStructure> && 
-  requires(CostStructure s, std::shared_ptr<const typename CostStructure::Solution> sol, size_t i)
+  requires(CostStructure s, const typename CostStructure::Solution& sol, size_t i)
   {
     { s.ComputeCost(sol, i) } -> std::same_as<typename CostStructure::T>;
     { s.Components() } -> std::same_as<size_t>;
@@ -123,7 +172,7 @@ namespace easylocal {
 
   template <class NeighborhoodExplorer>
   concept NeighborhoodExplorerT = has_basic_typedefs<NeighborhoodExplorer> && 
-requires(NeighborhoodExplorer ne, typename NeighborhoodExplorer::Solution& sol, std::shared_ptr<const typename NeighborhoodExplorer::Solution> cp_sol, std::shared_ptr<typename NeighborhoodExplorer::Solution> p_sol, typename NeighborhoodExplorer::Move mv) {
+requires(NeighborhoodExplorer ne, typename NeighborhoodExplorer::Solution& sol, const typename NeighborhoodExplorer::Solution& cp_sol, typename NeighborhoodExplorer::Solution& p_sol, typename NeighborhoodExplorer::Move mv) {
     typename NeighborhoodExplorer::SolutionManager;
     std::is_constructible_v<std::shared_ptr<const typename NeighborhoodExplorer::SolutionManager>>;
     typename NeighborhoodExplorer::Move;
@@ -137,4 +186,41 @@ requires(NeighborhoodExplorer ne, typename NeighborhoodExplorer::Solution& sol,
 requires(NeighborhoodExplorer ne, typename NeighborhoodExplorer::Solution& sol, typename NeighborhoodExplorer::Move mv1, typename NeighborhoodExplorer::Move mv2) {
     { ne.InverseMove(sol, mv1, mv2) } -> std::same_as<bool>;
   };
+
+  // A neighborhood explorer able to roll back a move applied in place
+  template <class NeighborhoodExplorer>
+  concept has_undo_move = 
+requires(NeighborhoodExplorer ne, typename NeighborhoodExplorer::Solution& p_sol, typename NeighborhoodExplorer::Move mv) {
+    { ne.UndoMove(p_sol, mv) };
+  };
+
+  // A neighborhood explorer whose MakeMove returns an undo token (e.g., the overwritten values), which is handed back to UndoMove
+  template <class NeighborhoodExplorer>
+  concept has_undo_token_move = 
+requires(NeighborhoodExplorer ne, typename NeighborhoodExplorer::Solution& p_sol, typename NeighborhoodExplorer::Move mv) {
+    requires !std::is_void_v<decltype(ne.MakeMove(p_sol, mv))>;
+    { ne.UndoMove(p_sol, mv, ne.MakeMove(p_sol, mv)) };
+  };
+
+  // A neighborhood explorer able to tell which blocks of a block-decomposable cost component are affected by a move
+  template <class NeighborhoodExplorer>
+  concept has_touched_blocks = 
+requires(NeighborhoodExplorer ne, const typename NeighborhoodExplorer::Solution& cp_sol, typename NeighborhoodExplorer::Move mv, size_t i, std::vector<size_t>& blocks) {
+    { ne.TouchedBlocks(cp_sol, mv, i, blocks) } -> std::same_as<bool>;
+  };
+
+  // A neighborhood explorer able to tell how a move changes the (Zobrist) hash of a solution: the std::hash of the new
+  // solution is the one of the old solution xor the delta
+  template <class NeighborhoodExplorer>
+  concept has_hash_delta = 
+requires(NeighborhoodExplorer ne, const typename NeighborhoodExplorer::Solution& cp_sol, typename NeighborhoodExplorer::Move mv) {
+    { ne.HashDelta(cp_sol, mv) } -> std::convertible_to<std::uint64_t>;
+  };
+
+  // A cost component whose weight and hardness are fixed at compile time (see FixedWeight)
+  template <class CostComponent>
+  concept has_fixed_weight = requires {
+    { CostComponent::weight };
+    { CostComponent::hard } -> std::convertible_to<bool>;
+  };
 }
@@ -0,0 +1,433 @@
+//
+//  cost-cache.hh
+//  easylocal
+//
+//  Lazily filled storage of the cost component values of solutions and moves.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <atomic>
+#include <thread>
+#include <cassert>
+#include "concepts.hh"
+
+// number of cost components whose values are stored inline (i.e., without heap allocation) by the cost cache
+#ifndef EASYLOCAL_INLINE_COST_COMPONENTS
+#define EASYLOCAL_INLINE_COST_COMPONENTS 8
+#endif
+
+namespace easylocal {
+
+  /// Cache of the values of the cost components. Values are kept in a contiguous T[] and the validity flags are
+  /// packed in a separate bitmask. Up to N components are stored inline, larger cost structures fall back to the heap.
+  template <Number T, size_t N = EASYLOCAL_INLINE_COST_COMPONENTS>
+  class CostCache
+  {
+    static_assert(N > 0 && N <= 64, "Inline cost components must fit in a single mask word");
+    using Mask = std::uint64_t;
+    static constexpr size_t mask_bits = 64;
+  public:
+    explicit CostCache(size_t components = 0) : components(components)
+    {
+      if (!IsInline())
+      {
+        heap_values = std::make_unique<T[]>(components);
+        heap_mask = std::make_unique<Mask[]>(MaskWords());
+      }
+    }
+
+    CostCache(const CostCache& other) : components(other.components), inline_mask(other.inline_mask)
+    {
+      if (IsInline())
+        std::copy(other.inline_values, other.inline_values + components, inline_values);
+      else
+      {
+        heap_values = std::make_unique_for_overwrite<T[]>(components);
+        heap_mask = std::make_unique_for_overwrite<Mask[]>(MaskWords());
+        std::copy(other.heap_values.get(), other.heap_values.get() + components, heap_values.get());
+        std::copy(other.heap_mask.get(), other.heap_mask.get() + MaskWords(), heap_mask.get());
+      }
+    }
+
+    CostCache(CostCache&& other) noexcept = default;
+
+    CostCache& operator=(const CostCache& other)
+    {
+      if (this == &other)
+        return *this;
+      if (!other.IsInline() && (IsInline() || components != other.components))
+      {
+        heap_values = std::make_unique_for_overwrite<T[]>(other.components);
+        heap_mask = std::make_unique_for_overwrite<Mask[]>(other.MaskWords());
+      }
+      components = other.components;
+      inline_mask = other.inline_mask;
+      std::copy(other.Values(), other.Values() + components, Data());
+      if (!IsInline())
+        std::copy(other.heap_mask.get(), other.heap_mask.get() + MaskWords(), heap_mask.get());
+      return *this;
+    }
+
+    CostCache& operator=(CostCache&& other) noexcept = default;
+
+    size_t size() const
+    {
+      return components;
+    }
+
+    bool IsValid(size_t i) const
+    {
+      assert(i < components);
+      return (MaskWord(i) >> (i % mask_bits)) & Mask(1);
+    }
+
+    bool AllValid() const
+    {
+      if (IsInline())
+        return inline_mask == FullMask(components);
+      for (size_t w = 0; w < MaskWords(); ++w)
+        if (heap_mask[w] != FullMask(std::min(mask_bits, components - w * mask_bits)))
+          return false;
+      return true;
+    }
+
+    T Get(size_t i) const
+    {
+      assert(IsValid(i));
+      return Values()[i];
+    }
+
+    void Set(size_t i, T value)
+    {
+      assert(i < components);
+      Data()[i] = value;
+      MaskWord(i) |= Mask(1) << (i % mask_bits);
+    }
+
+    void Invalidate(size_t i)
+    {
+      assert(i < components);
+      MaskWord(i) &= ~(Mask(1) << (i % mask_bits));
+    }
+
+    /// Returns the i-th value, calling fill (which must set it) when it is not available yet
+    template <typename F>
+    T GetOrCompute(size_t i, F&& fill)
+    {
+      if (!IsValid(i))
+        fill();
+      return Get(i);
+    }
+
+    /// Contiguous storage of the values, entries are meaningful only when valid
+    const T* Values() const
+    {
+      return IsInline() ? inline_values : heap_values.get();
+    }
+
+  protected:
+    bool IsInline() const
+    {
+      return components <= N;
+    }
+
+    size_t MaskWords() const
+    {
+      return (components + mask_bits - 1) / mask_bits;
+    }
+
+    static Mask FullMask(size_t bits)
+    {
+      return bits >= mask_bits ? ~Mask(0) : (Mask(1) << bits) - 1;
+    }
+
+    T* Data()
+    {
+      return IsInline() ? inline_values : heap_values.get();
+    }
+
+    Mask& MaskWord(size_t i)
+    {
+      return IsInline() ? inline_mask : heap_mask[i / mask_bits];
+    }
+
+    const Mask& MaskWord(size_t i) const
+    {
+      return IsInline() ? inline_mask : heap_mask[i / mask_bits];
+    }
+
+    size_t components;
+    Mask inline_mask = 0;
+    T inline_values[N]{};
+    std::unique_ptr<T[]> heap_values;
+    std::unique_ptr<Mask[]> heap_mask;
+  };
+
+  /// Concurrent counterpart of the cost cache, which can be filled by several threads at once. Each slot carries an
+  /// atomic state (empty, computing, ready) and the value is published with release semantics, hence readers never
+  /// block once a value is ready. A slot is computed only once: the thread that claims it runs the computation, the
+  /// others wait for the value to be published.
+  template <Number T>
+  class AtomicCostCache
+  {
+    enum : std::uint8_t { empty, computing, ready };
+    struct Slot
+    {
+      std::atomic<std::uint8_t> state{ empty };
+      std::atomic<T> value{};
+    };
+  public:
+    explicit AtomicCostCache(size_t components = 0) : components(components), slots(std::make_unique<Slot[]>(components)) {}
+
+    /// Copies the values already available (those being computed are left empty in the copy)
+    AtomicCostCache(const AtomicCostCache& other) : AtomicCostCache(other.components)
+    {
+      CopyFrom(other);
+    }
+
+    AtomicCostCache(AtomicCostCache&& other) noexcept = default;
+
+    AtomicCostCache& operator=(const AtomicCostCache& other)
+    {
+      if (this == &other)
+        return *this;
+      if (components != other.components)
+      {
+        components = other.components;
+        slots = std::make_unique<Slot[]>(components);
+      }
+      CopyFrom(other);
+      return *this;
+    }
+
+    AtomicCostCache& operator=(AtomicCostCache&& other) noexcept = default;
+
+    size_t size() const
+    {
+      return components;
+    }
+
+    bool IsValid(size_t i) const
+    {
+      assert(i < components);
+      return slots[i].state.load(std::memory_order_acquire) == ready;
+    }
+
+    bool AllValid() const
+    {
+      for (size_t i = 0; i < components; ++i)
+        if (!IsValid(i))
+          return false;
+      return true;
+    }
+
+    T Get(size_t i) const
+    {
+      assert(IsValid(i));
+      return slots[i].value.load(std::memory_order_relaxed);
+    }
+
+    /// Publishes the value; a concurrent computation of the same slot will store the same value again
+    void Set(size_t i, T value)
+    {
+      assert(i < components);
+      slots[i].value.store(value, std::memory_order_relaxed);
+      slots[i].state.store(ready, std::memory_order_release);
+    }
+
+    /// Not synchronized with the readers, the cache must be owned by the calling thread
+    void Invalidate(size_t i)
+    {
+      assert(i < components);
+      slots[i].state.store(empty, std::memory_order_relaxed);
+    }
+
+    /// Returns the i-th value, calling fill (which must set it) only in the thread that first claims the slot
+    template <typename F>
+    T GetOrCompute(size_t i, F&& fill)
+    {
+      assert(i < components);
+      Slot& slot = slots[i];
+      std::uint8_t state = slot.state.load(std::memory_order_acquire);
+      while (state != ready)
+      {
+        if (state == empty && slot.state.compare_exchange_weak(state, computing, std::memory_order_acquire, std::memory_order_acquire))
+        {
+          try
+          {
+            fill();
+          }
+          catch (...)
+          {
+            // release the claim, so that another thread may retry the computation
+            std::uint8_t claimed = computing;
+            slot.state.compare_exchange_strong(claimed, empty, std::memory_order_release);
+            throw;
+          }
+          assert(IsValid(i));
+          break;
+        }
+        if (state == computing)
+        {
+          std::this_thread::yield();
+          state = slot.state.load(std::memory_order_acquire);
+        }
+      }
+      return slot.value.load(std::memory_order_relaxed);
+    }
+
+  protected:
+    void CopyFrom(const AtomicCostCache& other)
+    {
+      for (size_t i = 0; i < components; ++i)
+      {
+        if (other.IsValid(i))
+          Set(i, other.Get(i));
+        else
+          slots[i].state.store(empty, std::memory_order_relaxed);
+      }
+    }
+
+    size_t components;
+    std::unique_ptr<Slot[]> slots;
+  };
+
+  /// Lazily computed scalar (e.g., the aggregated cost of a solution value). The value is stamped with the epoch it
+  /// has been computed in (e.g., the version of the weights of the cost structure), and it is computed again when it
+  /// is requested in a different epoch.
+  template <Number T>
+  class CachedValue
+  {
+  public:
+    bool IsValid(std::uint64_t epoch = 0) const
+    {
+      return value.has_value() && this->epoch == epoch;
+    }
+
+    template <typename F>
+    T GetOrCompute(std::uint64_t epoch, F&& compute)
+    {
+      if (!IsValid(epoch))
+      {
+        value = compute();
+        this->epoch = epoch;
+      }
+      return *value;
+    }
+
+    template <typename F>
+    T GetOrCompute(F&& compute)
+    {
+      return GetOrCompute(0, std::forward<F>(compute));
+    }
+
+    void Invalidate()
+    {
+      value.reset();
+    }
+
+  protected:
+    std::optional<T> value;
+    std::uint64_t epoch = 0;
+  };
+
+  /// Concurrent counterpart of the cached value; the value is deterministic, hence threads that find it missing
+  /// may compute it concurrently, the first one to finish publishing it. The epoch must not change while the value
+  /// is being computed by other threads.
+  template <Number T>
+  class AtomicCachedValue
+  {
+    // stamp of a missing value, actual epochs are stored shifted by one
+    static constexpr std::uint64_t invalid = 0;
+  public:
+    AtomicCachedValue() = default;
+
+    AtomicCachedValue(const AtomicCachedValue& other)
+    {
+      *this = other;
+    }
+
+    AtomicCachedValue& operator=(const AtomicCachedValue& other)
+    {
+      std::uint64_t stamp = other.stamp.load(std::memory_order_acquire);
+      if (stamp != invalid)
+        Publish(stamp, other.value.load(std::memory_order_relaxed));
+      else
+        Invalidate();
+      return *this;
+    }
+
+    bool IsValid(std::uint64_t epoch = 0) const
+    {
+      return stamp.load(std::memory_order_acquire) == epoch + 1;
+    }
+
+    template <typename F>
+    T GetOrCompute(std::uint64_t epoch, F&& compute)
+    {
+      if (!IsValid(epoch))
+        Publish(epoch + 1, compute());
+      return value.load(std::memory_order_relaxed);
+    }
+
+    template <typename F>
+    T GetOrCompute(F&& compute)
+    {
+      return GetOrCompute(0, std::forward<F>(compute));
+    }
+
+    void Invalidate()
+    {
+      stamp.store(invalid, std::memory_order_relaxed);
+    }
+
+  protected:
+    void Publish(std::uint64_t stamp, T v)
+    {
+      value.store(v, std::memory_order_relaxed);
+      this->stamp.store(stamp, std::memory_order_release);
+    }
+
+    std::atomic<std::uint64_t> stamp{ invalid };
+    std::atomic<T> value{};
+  };
+
+  /// Cache policy of the solution and move values: the sequential one (the default) pays no synchronization, the
+  /// concurrent one allows a solution value to be shared among evaluation threads
+  struct SequentialCachePolicy
+  {
+    template <Number T>
+    using Cache = CostCache<T>;
+    template <Number T>
+    using Value = CachedValue<T>;
+  };
+
+  struct ConcurrentCachePolicy
+  {
+    template <Number T>
+    using Cache = AtomicCostCache<T>;
+    template <Number T>
+    using Value = AtomicCachedValue<T>;
+  };
+
+  /// The cache policy declared by a cost structure (as CachePolicy), sequential if none
+  template <class CostStructure>
+  struct CachePolicyOf
+  {
+    using type = SequentialCachePolicy;
+  };
+
+  template <class CostStructure>
+  requires requires { typename CostStructure::CachePolicy; }
+  struct CachePolicyOf<CostStructure>
+  {
+    using type = typename CostStructure::CachePolicy;
+  };
+}
@@ -1,8 +1,26 @@
 #pragma once
 
 #include "concepts.hh"
+#include "cost-cache.hh"
+#include "thread-pool.hh"
+#include "transposition-table.hh"
+#include "evaluation-autotuner.hh"
+#include "dominance.hh"
 #include <vector>
+#include <tuple>
+#include <array>
+#include <utility>
+#include <optional>
+#include <numeric>
+#include <algorithm>
 #include <cassert>
+#include <compare>
+#include <functional>
+#include <type_traits>
+#include <ostream>
+#include <mutex>
+#include <atomic>
+#include <cmath>
 
 namespace easylocal {
 
@@ -14,7 +32,7 @@ public:
     /// Indeed the solution is not acquired by the cost component, but it is used only to
     /// compute the cost (this allows to avoid shared_ptr increment/decrement count which
     /// requires atomic operations and thread syncrhonization)
-    virtual T ComputeCost(std::shared_ptr<const Solution> s) const = 0;
+    virtual T ComputeCost(const Solution& s) const = 0;
     virtual ~CostComponent() = default;
 };
 
@@ -24,10 +42,396 @@ class DeltaCostComponent
 {
 public:
     /// Solution is passed as a const reference for performance reasons (see above in @CostComponent)
-    virtual T ComputeDeltaCost(std::shared_ptr<const Solution> s, const Move& mv) const = 0;
+    virtual T ComputeDeltaCost(const Solution& s, const Move& mv) const = 0;
+    // A delta cost component may also provide a batched evaluation over a chunk of moves (e.g., to vectorize across moves)
+    //   void ComputeDeltaCosts(const Solution& s, std::span<const Move> mvs, std::span<T> deltas) const
+    // which is detected by the neighborhood explorer (see BatchDeltaCostComponentT) and used when a chunk of moves is evaluated
+    // It may also tell which moves may change its value at all
+    //   bool Affects(const Solution& s, const Move& mv) const
+    // so that the value of the other moves is taken from the originating solution without evaluation (see FilteredDeltaCostComponentT),
+    // and a cheap lower bound of its delta
+    //   T LowerBoundDelta(const Solution& s, const Move& mv) const
+    // which bounded comparisons use to discard moves before computing the exact delta (see BoundedDeltaCostComponentT)
     virtual ~DeltaCostComponent() = default;
 };
 
+/// A cost component that computes the values of several (consecutive) cost components at once, e.g., with a single
+/// scan of the solution, which are all stored in the cache of the solution value when one of them is requested
+template <InputT Input, SolutionT<Input> Solution, Number T>
+class FusedCostComponent
+{
+public:
+    virtual size_t Components() const = 0;
+    virtual void ComputeCosts(const Solution& s, std::span<T> costs) const = 0;
+    virtual ~FusedCostComponent() = default;
+};
+
+/// The delta counterpart of a fused cost component, it computes the deltas of several cost components at once
+template <InputT Input, SolutionT<Input> Solution, Number T, typename Move>
+class FusedDeltaCostComponent
+{
+public:
+    virtual size_t Components() const = 0;
+    virtual void ComputeDeltaCosts(const Solution& s, const Move& mv, std::span<T> deltas) const = 0;
+    virtual ~FusedDeltaCostComponent() = default;
+};
+
+/// Exposes one of the values of a fused cost component as a regular cost component
+template <InputT Input, SolutionT<Input> Solution, Number T>
+class FusedCostComponentSlot : public CostComponent<Input, Solution, T>
+{
+public:
+    FusedCostComponentSlot(std::shared_ptr<const FusedCostComponent<Input, Solution, T>> fcc, size_t first, size_t offset) : fcc(fcc), first(first), offset(offset) {}
+    
+    T ComputeCost(const Solution& s) const override
+    {
+        // per-thread scratch buffer, so that evaluations do not allocate
+        thread_local std::vector<T> costs;
+        costs.assign(fcc->Components(), T(0));
+        fcc->ComputeCosts(s, costs);
+        return costs[offset];
+    }
+    
+    /// Computes all the values of the fused cost component in a single pass and stores them in the cache
+    template <class Cache>
+    void ComputeCosts(const Solution& s, Cache& cache) const
+    {
+        thread_local std::vector<T> costs;
+        costs.assign(fcc->Components(), T(0));
+        fcc->ComputeCosts(s, costs);
+        for (size_t j = 0; j < costs.size(); ++j)
+            cache.Set(first + j, costs[j]);
+    }
+    
+    /// Index of the first cost component computed by the fused cost component
+    size_t First() const
+    {
+        return first;
+    }
+    
+protected:
+    std::shared_ptr<const FusedCostComponent<Input, Solution, T>> fcc;
+    size_t first, offset;
+};
+
+/// Auxiliary data kept by a cost component alongside a solution (e.g., counters, conflict matrices or prefix sums),
+/// it is attached to the solution values and updated incrementally when a move is committed
+class CostComponentState
+{
+public:
+    virtual std::unique_ptr<CostComponentState> Clone() const = 0;
+    virtual ~CostComponentState() = default;
+};
+
+template <class State>
+class CostComponentStateOf : public CostComponentState
+{
+public:
+    template <typename ...Args>
+    explicit CostComponentStateOf(Args&& ...args) : state(std::forward<Args>(args)...) {}
+    
+    std::unique_ptr<CostComponentState> Clone() const override
+    {
+        return std::make_unique<CostComponentStateOf>(*this);
+    }
+    
+    State state;
+};
+
+/// A cost component owning a state, which is built from the solution when a solution value is created
+/// (i.e., State must be constructible from a const Solution&)
+template <InputT Input, SolutionT<Input> Solution, Number T, class _State>
+class StatefulCostComponent : public CostComponent<Input, Solution, T>
+{
+public:
+    using State = _State;
+};
+
+/// A delta cost component reading the state of the corresponding (stateful) cost component, which it is also
+/// in charge of keeping up to date when a move is committed
+template <InputT Input, SolutionT<Input> Solution, Number T, typename Move, class _State>
+class StatefulDeltaCostComponent : public DeltaCostComponent<Input, Solution, T, Move>
+{
+public:
+    using State = _State;
+    virtual T ComputeDeltaCost(const Solution& s, const State& st, const Move& mv) const = 0;
+    /// Updates the state of the solution s so that it reflects the solution obtained by applying the move to s
+    virtual void UpdateState(State& st, const Solution& s, const Move& mv) const = 0;
+    
+    /// Only for callers holding a bare solution, the state is built on the fly for each call. The neighborhood
+    /// explorer always passes the state attached to the solution value instead, and asserts that it is there
+    /// (batched delta cost components are bypassed when a state is attached).
+    T ComputeDeltaCost(const Solution& s, const Move& mv) const override
+    {
+        return this->ComputeDeltaCost(s, State(s), mv);
+    }
+};
+
+/// A delta cost component returning a fast estimate of the delta (e.g., of a simulation-based cost). The values of the
+/// committed moves are brought back to the exact cost of the component according to the resynchronization schedule
+/// of the neighborhood explorer, which also reports how far they have drifted (see DriftTracker).
+template <InputT Input, SolutionT<Input> Solution, Number T, typename Move>
+class ApproximateDeltaCostComponent : public DeltaCostComponent<Input, Solution, T, Move>
+{};
+
+/// Absolute difference between the values of a cost component accumulated through approximate deltas and its exact
+/// cost, measured at the resynchronizations
+struct DriftStatistics
+{
+    size_t resynchronizations = 0;
+    double total_drift = 0.0, max_drift = 0.0;
+    
+    double MeanDrift() const
+    {
+        return resynchronizations > 0 ? total_drift / resynchronizations : 0.0;
+    }
+};
+
+/// Resynchronization schedule of the values computed by approximate delta cost components, and drift statistics per
+/// cost component. Every period-th committed move is resynchronized (1 resynchronizes them all, 0 none, so that
+/// values are resynchronized only on request, see SolutionValue::Resynchronize).
+template <Number T>
+class DriftTracker
+{
+public:
+    DriftTracker() = default;
+    
+    DriftTracker(const DriftTracker& other) : period(other.period), statistics(other.GetStatistics())
+    {}
+    
+    void SetPeriod(size_t period)
+    {
+        this->period = period;
+    }
+    
+    size_t GetPeriod() const
+    {
+        return period;
+    }
+    
+    /// Counts a committed move, returns whether its values have to be resynchronized
+    bool Commit()
+    {
+        if (period == 0)
+            return false;
+        return (commits.fetch_add(1, std::memory_order_relaxed) + 1) % period == 0;
+    }
+    
+    void Record(size_t i, T approximate, T exact)
+    {
+        double drift = std::abs(double(approximate) - double(exact));
+        std::lock_guard<std::mutex> lock(mutex);
+        if (statistics.size() <= i)
+            statistics.resize(i + 1);
+        statistics[i].resynchronizations++;
+        statistics[i].total_drift += drift;
+        statistics[i].max_drift = std::max(statistics[i].max_drift, drift);
+    }
+    
+    DriftStatistics GetStatistics(size_t i) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return i < statistics.size() ? statistics[i] : DriftStatistics();
+    }
+    
+    std::vector<DriftStatistics> GetStatistics() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return statistics;
+    }
+    
+protected:
+    size_t period = 1;
+    std::atomic<size_t> commits{ 0 };
+    std::vector<DriftStatistics> statistics;
+    mutable std::mutex mutex;
+};
+
+/// A cost component which is the sum of the costs of independent blocks (e.g., machines, days or routes). The block
+/// costs are kept as the state of the solution values, so that the value of a move is obtained by recomputing only
+/// the blocks it touches, as reported by the TouchedBlocks hook of the neighborhood explorer.
+template <InputT Input, SolutionT<Input> Solution, Number T>
+class DecomposableCostComponent : public CostComponent<Input, Solution, T>
+{
+public:
+    virtual size_t Blocks(const Solution& s) const = 0;
+    virtual T ComputeBlockCost(const Solution& s, size_t b) const = 0;
+    
+    T ComputeCost(const Solution& s) const override
+    {
+        T cost = 0;
+        for (size_t b = 0; b < this->Blocks(s); ++b)
+            cost += this->ComputeBlockCost(s, b);
+        return cost;
+    }
+    
+    std::vector<T> ComputeBlockCosts(const Solution& s) const
+    {
+        std::vector<T> costs(this->Blocks(s));
+        for (size_t b = 0; b < costs.size(); ++b)
+            costs[b] = this->ComputeBlockCost(s, b);
+        return costs;
+    }
+};
+
+/// A cost component which is the sum of the costs of the elements of a (large) range, e.g., the jobs or the customers
+/// of the instance. When the cost structure evaluates in parallel, the range is split in chunks whose costs are
+/// computed concurrently and then summed up.
+template <InputT Input, SolutionT<Input> Solution, Number T>
+class ChunkedCostComponent : public CostComponent<Input, Solution, T>
+{
+public:
+    virtual size_t Elements(const Solution& s) const = 0;
+    /// Cost of the elements in [begin, end)
+    virtual T ComputeCost(const Solution& s, size_t begin, size_t end) const = 0;
+    
+    T ComputeCost(const Solution& s) const override
+    {
+        return this->ComputeCost(s, 0, this->Elements(s));
+    }
+};
+
+/// Per-thread scratch copy of a solution, on which moves are applied and undone in place to evaluate the cost
+/// components without deltas. It is kept in sync with the last solution it has been acquired for, whose ownership is
+/// shared so that its address cannot be reused by a different solution in the meantime.
+template <class Solution>
+class ScratchSolution
+{
+public:
+    static Solution& Acquire(const std::shared_ptr<const Solution>& source)
+    {
+        auto& scratch = Instance();
+        if (scratch.source != source)
+        {
+            // copy assignment reuses the memory already allocated by the scratch solution
+            if constexpr (std::is_copy_assignable_v<Solution>)
+            {
+                if (scratch.solution)
+                    *scratch.solution = *source;
+                else
+                    scratch.solution = std::make_shared<Solution>(*source);
+            }
+            else
+                scratch.solution = std::make_shared<Solution>(*source);
+            scratch.source = source;
+        }
+        return *scratch.solution;
+    }
+    
+    /// To be called when the scratch solution is not in sync with its source anymore (e.g., a move is being applied)
+    static void Invalidate()
+    {
+        Instance().source.reset();
+    }
+    
+    static void Validate(const std::shared_ptr<const Solution>& source)
+    {
+        Instance().source = source;
+    }
+    
+protected:
+    static ScratchSolution& Instance()
+    {
+        thread_local ScratchSolution scratch;
+        return scratch;
+    }
+    
+    std::shared_ptr<const Solution> source;
+    std::shared_ptr<Solution> solution;
+};
+
+/// Computes the values of all the cost components of a solution, on the thread pool if any. The components are
+/// evaluated concurrently, fused components once for all their values, and chunked components are further split
+/// in ranges of chunk_size elements whose costs are summed up.
+template <InputT Input, SolutionT<Input> Solution, Number T>
+std::vector<T> ComputeAllCosts(ThreadPool* pool, size_t chunk_size, const Solution& sol,
+                               const std::vector<std::unique_ptr<CostComponent<Input, Solution, T>>>& cost_components,
+                               const std::vector<const FusedCostComponentSlot<Input, Solution, T>*>& fused_slots,
+                               const std::vector<const ChunkedCostComponent<Input, Solution, T>*>& chunked_components)
+{
+    struct Task
+    {
+        size_t i, begin, end;
+    };
+    // the values of a fused cost component are written directly by the task computing its first one
+    struct Values
+    {
+        void Set(size_t i, T value)
+        {
+            costs[i] = value;
+        }
+        std::vector<T>& costs;
+    };
+    std::vector<T> costs(cost_components.size(), T(0));
+    std::vector<Task> tasks;
+    for (size_t i = 0; i < cost_components.size(); ++i)
+    {
+        if (chunked_components[i] && pool)
+        {
+            size_t n = chunked_components[i]->Elements(sol);
+            for (size_t begin = 0; begin < n; begin += chunk_size)
+                tasks.push_back({ i, begin, std::min(begin + chunk_size, n) });
+        }
+        else if (!fused_slots[i] || fused_slots[i]->First() == i)
+            tasks.push_back({ i, 0, 0 });
+    }
+    std::vector<T> partial_costs(tasks.size(), T(0));
+    Values values{ costs };
+    auto compute = [&](size_t k) {
+        const Task& task = tasks[k];
+        if (fused_slots[task.i])
+            fused_slots[task.i]->ComputeCosts(sol, values);
+        else if (task.end > task.begin)
+            partial_costs[k] = chunked_components[task.i]->ComputeCost(sol, task.begin, task.end);
+        else
+            partial_costs[k] = cost_components[task.i]->ComputeCost(sol);
+    };
+    if (pool)
+        pool->ParallelFor(tasks.size(), compute);
+    else
+        for (size_t k = 0; k < tasks.size(); ++k)
+            compute(k);
+    for (size_t k = 0; k < tasks.size(); ++k)
+        if (!fused_slots[tasks[k].i])
+            costs[tasks[k].i] += partial_costs[k];
+    return costs;
+}
+
+/// A chunk of moves whose deltas are computed at once by batched delta cost components (see BatchDeltaCostComponentT).
+/// The move values of the chunk share it, and the deltas of a component are computed for the whole chunk only when
+/// the first of them needs the value of the component, so that comparisons evaluating the components lazily do not
+/// pay for the components they never reach.
+template <Number T, class Move>
+class MoveBatch
+{
+public:
+    MoveBatch(std::span<const Move> moves, size_t components) : moves(moves.begin(), moves.end()), deltas(components), evaluated(components), flags(std::make_unique<std::once_flag[]>(components))
+    {}
+
+    const std::vector<Move>& Moves() const
+    {
+        return moves;
+    }
+
+    /// Delta of the i-th component for the k-th move, compute(i, deltas, evaluated) is called once per component to fill
+    /// the deltas of the moves it evaluates; nullopt when the k-th move has not been evaluated (e.g., it does not affect
+    /// the component) and has to be evaluated on its own
+    template <typename F>
+    std::optional<T> Delta(size_t i, size_t k, F&& compute) const
+    {
+        std::call_once(flags[i], [&]() { compute(i, deltas[i], evaluated[i]); });
+        if (k >= evaluated[i].size() || !evaluated[i][k])
+            return std::nullopt;
+        return deltas[i][k];
+    }
+
+protected:
+    std::vector<Move> moves;
+    mutable std::vector<std::vector<T>> deltas;
+    mutable std::vector<std::vector<bool>> evaluated;
+    std::unique_ptr<std::once_flag[]> flags;
+};
+
 template <InputT Input, SolutionT<Input> _Solution, Number _T, CostStructureTd _CostStructure, class NeighborhoodExplorer>
 class MoveValue;
 
@@ -38,11 +442,14 @@ template <SolutionManagerT SolutionManager, class NE, class ...NHEs>
 requires (NeighborhoodExplorerT<NHEs> && ...)
 class UnionNeighborhoodExplorer;
 
-template <InputT _Input, SolutionT<_Input> _Solution, Number _T>
+template <InputT _Input, SolutionT<_Input> _Solution, Number _T, class _CachePolicy, class _CostStructure>
+class DynamicCostStructure;
+
+template <InputT _Input, SolutionT<_Input> _Solution, Number _T, class _CachePolicy = SequentialCachePolicy>
 class AggregatedCostStructure;
 
 template <InputT _Input, SolutionT<_Input> _Solution, Number _T, class _CostStructure>
-class SolutionValue : std::vector<std::pair<bool, _T>>
+class SolutionValue
 {
 public:
     using Input = _Input ;
@@ -50,20 +457,28 @@ public:
     using T = _T;
     using CostStructure = _CostStructure ;
     friend CostStructure;
+    template <InputT I, SolutionT<I> S, Number T_, class CP, class CS> friend class DynamicCostStructure;
     template <InputT I, SolutionT<I> S, Number T_, CostStructureTd CS, class NE> friend class MoveValue;
     template <SolutionManagerT SM, class Move, class NE> friend class NeighborhoodExplorer;
     template <SolutionManagerT SM, class NE, class ...NHEs> requires (NeighborhoodExplorerT<NHEs> && ...) friend class UnionNeighborhoodExplorer;
     
-    std::shared_ptr<const Solution> GetSolution() const
+    const std::shared_ptr<const Solution>& GetSolution() const
     {
         return sol;
     }
     
-    // TODO: this is a bit patchy, just to access a single scalar in case of aggregated costs due to its use in TS, review in another life
-    template <typename = std::enable_if<std::same_as<CostStructure, class AggregatedCostStructure<Input, Solution, T>>>>
-    T AggregatedCost() const
+    /// Hash of the solution, known when the cost structure uses a transposition table
+    std::optional<std::uint64_t> Hash() const
     {
-        return cs->ComputeAggregatedCost(*this);
+        return hash;
+    }
+    
+    /// Single scalar summarizing the value, available only for cost structures that aggregate their components
+    T AggregatedCost() const requires requires(const CostStructure& cs, const SolutionValue& sv) { cs.ComputeAggregatedCost(sv); }
+    {
+        // the aggregated cost is cached, since it is used by every comparison, and computed again from the cached values
+        // of the components when the weights of the cost structure change
+        return aggregated_cost.GetOrCompute(this->WeightsEpoch(), [this]() { return cs->ComputeAggregatedCost(*this); });
     }
     
     std::vector<T> GetValues() const
@@ -75,27 +490,53 @@ public:
         return tmp;
     }
     
+    /// Whether the values match the costs of the solution (values obtained through approximate delta cost components
+    /// match them only after a resynchronization, see IsApproximate)
     bool CheckValues() const
     {
-        for (size_t i = 0; i < this->size(); ++i)
-            if (cs->ComputeCost(sol, i) != (*this)[i])
-                return false;
+        // cost structures able to compute all the values at once (possibly in parallel) check them as a whole
+        if constexpr (requires { cs->ComputeCosts(*sol); })
+        {
+            std::vector<T> costs = cs->ComputeCosts(*sol);
+            for (size_t i = 0; i < this->size(); ++i)
+                if (costs[i] != (*this)[i])
+                    return false;
+        }
+        else
+        {
+            for (size_t i = 0; i < this->size(); ++i)
+                if (cs->ComputeCost(*sol, i) != (*this)[i])
+                    return false;
+        }
         return true;
     }
     
     T operator[](size_t i) const
     {
-        //const std::lock_guard<std::mutex> lock(compute);
-        auto& val = const_cast<std::pair<bool, T>&>(std::vector<std::pair<bool, T>>::operator[](i));
-        if (!val.first)
-        {
-            val.second = cs->ComputeCost(sol, i);
-            val.first = true;
-        }
-        return val.second;
+        // with a concurrent cache policy each value is computed by a single thread, even if the solution value is shared
+        return cache.GetOrCompute(i, [this, i]() {
+            // cost structures supporting fused components fill all the values computed together with the i-th one
+            if constexpr (requires { cs->ComputeCost(*sol, i, cache); })
+                cs->ComputeCost(*sol, i, cache);
+            else
+                cache.Set(i, cs->ComputeCost(*sol, i));
+        });
+    }
+    
+    size_t size() const
+    {
+        return cache.size();
     }
     
-    using std::vector<std::pair<bool, T>>::size;
+    /// Contiguous values of all the components when they have all been computed already (nullptr otherwise, or when
+    /// the cache policy does not store them contiguously), which allows comparisons to be vectorized
+    const T* ComputedValues() const
+    {
+        if constexpr (requires { cache.Values(); })
+            return cache.AllValid() ? cache.Values() : nullptr;
+        else
+            return nullptr;
+    }
     
     template <SolutionValueT<Input, Solution, T, CostStructure> SV>
     auto operator<=>(const SV& other) const
@@ -115,32 +556,163 @@ public:
         return cs->equality(*this, other);
     }
     
+    /// Strict comparison which, when supported by the cost structure, stops evaluating the components of this value as
+    /// soon as it is proven not to be less than other (whose values are expected to be already available)
+    template <SolutionValueT<Input, Solution, T, CostStructure> SV>
+    bool BoundedLess(const SV& other) const
+    {
+        if constexpr (requires { cs->bounded_less(*this, other); })
+            return cs->bounded_less(*this, other);
+        else
+            return *this < other;
+    }
+    
     template <NeighborhoodExplorerT NeighborhoodExplorer>
-    SolutionValue(const MoveValue<Input, Solution, T, _CostStructure, NeighborhoodExplorer>& m) : cs(m.cs), sol(m.GetSolution())
+    SolutionValue(const MoveValue<Input, Solution, T, _CostStructure, NeighborhoodExplorer>& m) : cs(m.old_sv->cs), sol(m.GetSolution())
     {
-        auto values = m.GetValues();
-        this->reserve(m.size());
-        for (size_t i = 0; i < values.size(); ++i)
-            (*this).push_back({ true, values[i] });
+        // all the values of the move are needed, the resulting cache is copied as a whole
+        m.ComputeValues();
+        cache = m.cache;
+        states = m.ComputeStates();
+        hash = m.Hash();
+        // values taken from the transposition table are exact, the others computed by approximate delta cost components
+        // are brought back to the exact costs according to the resynchronization schedule of the neighborhood explorer,
+        // which records their drift
+        approximate = m.old_sv->approximate && !m.transposed;
+        if (!m.transposed && m.ne->HasApproximateDeltaCostComponents())
+        {
+            if (m.ne->ScheduleResynchronization())
+            {
+                for (size_t i = 0; i < this->size(); ++i)
+                    if (m.ne->IsApproximate(i))
+                    {
+                        T value = cache.Get(i);
+                        m.ne->RecordDrift(i, value, this->Resynchronize(i));
+                    }
+                approximate = false;
+            }
+            else
+                approximate = true;
+        }
+        // the values of the new solution are stored in the transposition table, unless they have been taken from it
+        if constexpr (requires { cs->GetTranspositionTable(); })
+            if (auto* table = cs->GetTranspositionTable(); table && hash && !m.transposed && !approximate)
+                table->Store(*hash, this->GetValues());
     }
     
-    SolutionValue(const SolutionValue<Input, Solution, T, _CostStructure>& s) : cs(s.cs), sol(s.sol), std::vector<std::pair<bool, T>>(s)
+    SolutionValue(const SolutionValue<Input, Solution, T, _CostStructure>& s) : cs(s.cs), sol(s.sol), cache(s.cache), aggregated_cost(s.aggregated_cost), states(s.states), hash(s.hash), approximate(s.approximate)
     {}
     
+    SolutionValue& operator=(const SolutionValue& s) = default;
+    
+    /// Whether the values may have drifted from the exact costs, since they have been obtained through approximate delta
+    /// cost components and not resynchronized yet
+    bool IsApproximate() const
+    {
+        return approximate;
+    }
+    
+    /// Replaces the (possibly approximate) values of all the components with the exact costs of the solution
+    void Resynchronize()
+    {
+        for (size_t i = 0; i < this->size(); ++i)
+            this->Resynchronize(i);
+        approximate = false;
+    }
+    
+    /// State of the i-th cost component (nullptr for stateless components)
+    const CostComponentState* GetState(size_t i) const
+    {
+        return i < states.size() ? states[i].get() : nullptr;
+    }
+    
+    template <class State>
+    const State& GetState(size_t i) const
+    {
+        assert(dynamic_cast<const CostComponentStateOf<State>*>(this->GetState(i)) != nullptr);
+        return static_cast<const CostComponentStateOf<State>*>(this->GetState(i))->state;
+    }
+    
 protected:
-    SolutionValue(std::shared_ptr<const CostStructure> cs, std::shared_ptr<const Solution> sol, size_t components) : cs(cs), sol(sol), std::vector<std::pair<bool, T>>(components, { false, 0 })
+    using CachePolicy = typename CachePolicyOf<CostStructure>::type;
+    using Cache = typename CachePolicy::template Cache<T>;
+    
+    SolutionValue(std::shared_ptr<const CostStructure> cs, std::shared_ptr<const Solution> sol, size_t components) : cs(cs), sol(sol), cache(components)
     {
         assert(cs && sol);
+        if (cs->HasStatefulComponents())
+        {
+            states.resize(components);
+            for (size_t i = 0; i < components; ++i)
+                states[i] = cs->CreateState(*sol, i);
+        }
+    }
+    /// Version of the weights of the cost structure (for cost structures whose weights can change)
+    std::uint64_t WeightsEpoch() const
+    {
+        if constexpr (requires { cs->WeightsEpoch(); })
+            return cs->WeightsEpoch();
+        else
+            return 0;
+    }
+    
+    /// Fills the cache with the values of all the components, computed at once by the cost structure
+    void SetValues(const std::vector<T>& costs)
+    {
+        assert(costs.size() == cache.size());
+        for (size_t i = 0; i < costs.size(); ++i)
+            cache.Set(i, costs[i]);
+    }
+    
+    /// Replaces the value of the i-th component with its exact cost, which is returned
+    T Resynchronize(size_t i)
+    {
+        T exact = cs->ComputeCost(*sol, i);
+        cache.Set(i, exact);
+        aggregated_cost.Invalidate();
+        return exact;
+    }
+    
+    /// Takes the values of all the components from the transposition table when the solution has been evaluated
+    /// already, otherwise computes them at once and stores them in the table
+    void Transpose(TranspositionTable<T>& table)
+    {
+        if constexpr (std::is_default_constructible_v<std::hash<Solution>>)
+        {
+            hash = std::hash<Solution>{}(*sol);
+            thread_local std::vector<T> values;
+            values.resize(this->size());
+            if (!table.Load(*hash, values))
+            {
+                values = cs->ComputeCosts(*sol);
+                table.Store(*hash, values);
+            }
+            this->SetValues(values);
+        }
     }
-    using std::vector<std::pair<bool, T>>::begin;
-    using std::vector<std::pair<bool, T>>::end;
-    using std::vector<std::pair<bool, T>>::at;
+    
     std::shared_ptr<const CostStructure> cs;
     std::shared_ptr<const Solution> sol;
+    mutable Cache cache;
+    mutable typename CachePolicy::template Value<T> aggregated_cost;
+    // states are immutable once attached, hence they are shared among the copies of the solution value
+    std::vector<std::shared_ptr<const CostComponentState>> states;
+    std::optional<std::uint64_t> hash;
+    bool approximate = false;
 };
 
+/// Prints the values of the cost components (it computes all of them)
+template <InputT Input, SolutionT<Input> Solution, Number T, class CostStructure>
+std::ostream& operator<<(std::ostream& os, const SolutionValue<Input, Solution, T, CostStructure>& sv)
+{
+    os << "(";
+    for (size_t i = 0; i < sv.size(); ++i)
+        os << (i > 0 ? ", " : "") << sv[i];
+    return os << ")";
+}
+
 template <InputT _Input, SolutionT<_Input> _Solution, Number _T, CostStructureTd _CostStructure, class _NeighborhoodExplorer>
-class MoveValue : std::vector<std::pair<bool, _T>>
+class MoveValue
 {
 public:
     using Input = _Input;
@@ -160,11 +732,12 @@ public:
         return mv;
     }
     
-    // TODO: this is a bit patchy, just to access a single scalar in case of aggregated costs due to its use in TS, review in another life
-    template <typename = std::enable_if<std::same_as<CostStructure, class AggregatedCostStructure<Input, Solution, T>>>>
-    T AggregatedCost() const
+    /// Single scalar summarizing the value, available only for cost structures that aggregate their components
+    T AggregatedCost() const requires requires(const CostStructure& cs, const SolutionValue& sv) { cs.ComputeAggregatedCost(sv); }
     {
-        return this->GetSolutionValue().AggregatedCost();
+        // derived from the aggregated cost of the originating solution and the weighted deltas of the components,
+        // without materializing the new solution
+        return aggregated_cost.GetOrCompute(this->WeightsEpoch(), [this]() { return old_sv->AggregatedCost() + cs->ComputeAggregatedDelta(*this, *old_sv); });
     }
     
     std::vector<T> GetValues() const
@@ -178,30 +751,48 @@ public:
     
     T operator[](size_t i) const
     {
-        auto& val = const_cast<std::pair<bool, T>&>(std::vector<std::pair<bool, T>>::operator[](i));
-        if (!val.first)
-        {
+        return cache.GetOrCompute(i, [this, i]() {
+            // a solution visited already takes all its values from the transposition table
+            if (this->Transpose())
+                return;
+            // the move is known not to affect the component, hence its value is unchanged
+            if (!ne->Affects(*old_sv->GetSolution(), mv, i))
+            {
+                cache.Set(i, (*old_sv)[i]);
+                return;
+            }
             // the value has to be computed
-            if (ne->HasDeltaCostComponent(i, mv))
+            if (ne->HasFusedDeltaCostComponent(i, mv))
             {
-                val.second = old_sv[i] + ne->ComputeDeltaCost(old_sv.GetSolution(), mv, i);
-                val.first = true;
+                // all the values covered by the fused delta cost component are filled at once
+                ne->ComputeFusedDeltaCosts(*old_sv, mv, i, cache);
             }
-            else
+            else if (auto delta = this->BatchDelta(i))
             {
-                if (!new_sol)
-                {
-                    // make a copy of the solution
-                    new_sol = std::make_shared<Solution>(*(old_sv.GetSolution()));
-                    // apply the move
-                    ne->MakeMove(new_sol, mv);
-                }
-                // compute the new cost directly from solution
-                val.second = cs->ComputeCost(new_sol, i);
-                val.first = true;
+                // the delta has been computed together with those of the other moves of the chunk
+                cache.Set(i, (*old_sv)[i] + *delta);
             }
-        }
-        return val.second;
+            else if (ne->HasDeltaCostComponent(i, mv))
+            {
+                // the autotuner of the neighborhood explorer may have found the full evaluation faster than the delta
+                auto [strategy, timed] = ne->SelectEvaluationStrategy(i, mv);
+                // a timed full evaluation measures only the cost of the new solution, which is materialized before the
+                // clock starts, so that the timings do not depend on whether the move is applied in place or on a copy
+                if (timed && strategy == EvaluationStrategy::Full)
+                    this->GetSolution();
+                auto start = timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+                if (strategy == EvaluationStrategy::Delta)
+                    cache.Set(i, (*old_sv)[i] + ne->ComputeDeltaCost(*old_sv, mv, i));
+                else
+                    this->ComputeFullCost(i);
+                if (timed)
+                    ne->RecordEvaluationTime(i, mv, strategy, std::chrono::steady_clock::now() - start);
+            }
+            else if (!this->ComputeBlockDelta(i))
+            {
+                this->ComputeFullCost(i);
+            }
+        });
     }
     
     template <SolutionValueT<Input, Solution, T, CostStructure> SV>
@@ -216,13 +807,26 @@ public:
         return cs->equality(*this, other);
     }
     
+    /// Strict comparison which, when supported by the cost structure, stops evaluating the components of this value as
+    /// soon as it is proven not to be less than other (whose values are expected to be already available)
+    template <SolutionValueT<Input, Solution, T, CostStructure> SV>
+    bool BoundedLess(const SV& other) const
+    {
+        if constexpr (requires { cs->bounded_less(*this, other); })
+            return cs->bounded_less(*this, other);
+        else
+            return *this < other;
+    }
+    
+    /// The new solution, which is materialized (i.e., copied from the originating one and modified by the move) on the
+    /// first call; solutions built on persistent containers (see PersistentVector) make the copy cheap
     std::shared_ptr<const Solution> GetSolution() const
     {
         // the new solution has not been determined yet
         if (!new_sol)
         {
-            new_sol = std::make_shared<Solution>(*(old_sv.GetSolution())); // make a copy of the solution
-            ne->MakeMove(new_sol, mv);
+            new_sol = std::make_shared<Solution>(*(old_sv->GetSolution())); // make a copy of the solution
+            ne->MakeMove(*new_sol, mv);
         }
         return new_sol;
     }
@@ -232,61 +836,574 @@ public:
         return cs->CreateSolutionValue(this->GetSolution());
     }
     
-    using std::vector<std::pair<bool, T>>::size;
+    /// Lower bound of the value of the i-th component which does not require its exact evaluation: the value itself when
+    /// it is known already (or the move does not affect the component), otherwise the old value plus the lower bound of
+    /// the delta, if the delta cost component provides one (see BoundedDeltaCostComponentT)
+    std::optional<T> LowerBound(size_t i) const
+    {
+        if (cache.IsValid(i))
+            return cache.Get(i);
+        if (!ne->Affects(*old_sv->GetSolution(), mv, i))
+            return (*old_sv)[i];
+        if (auto lb = ne->LowerBoundDelta(*old_sv->GetSolution(), mv, i))
+            return (*old_sv)[i] + *lb;
+        return std::nullopt;
+    }
+    
+    /// Hash of the new solution, derived from the one of the originating solution value when the neighborhood explorer
+    /// reports how moves change it (see has_hash_delta)
+    std::optional<std::uint64_t> Hash() const
+    {
+        if constexpr (has_hash_delta<_NeighborhoodExplorer>)
+        {
+            if (old_sv->hash)
+                return *old_sv->hash ^ std::uint64_t(ne->HashDelta(*old_sv->GetSolution(), mv));
+        }
+        return std::nullopt;
+    }
+    
+    size_t size() const
+    {
+        return cache.size();
+    }
+    
+    /// See SolutionValue::ComputedValues
+    const T* ComputedValues() const
+    {
+        if constexpr (requires { cache.Values(); })
+            return cache.AllValid() ? cache.Values() : nullptr;
+        else
+            return nullptr;
+    }
     
-    MoveValue(const MoveValue<Input, Solution, T, _CostStructure, NeighborhoodExplorer>& m) : cs(m.cs), ne(m.ne), new_sol(m.new_sol), old_sv(m.old_sv), std::vector<std::pair<bool, T>>(m)
+    MoveValue(const MoveValue& m) : cs(m.cs), ne(m.ne), mv(m.mv), old_sv(m.old_sv), owned_sv(m.owned_sv), new_sol(m.new_sol), cache(m.cache), aggregated_cost(m.aggregated_cost), batch(m.batch), batch_index(m.batch_index), looked_up(m.looked_up), transposed(m.transposed)
     {}
     
+    MoveValue& operator=(const MoveValue& m) = default;
+    
+    /// A move value only refers to the solution value it originates from (and to the neighborhood explorer and the cost
+    /// structure), which must therefore outlive it. Runners that keep a move value beyond the lifetime of its
+    /// originating solution value (e.g., the best move of a tabu search iteration) have to detach it first, so that
+    /// it acquires its own copy of the solution value.
+    void Detach()
+    {
+        if (!owned_sv)
+        {
+            owned_sv = std::make_shared<const SolutionValue>(*old_sv);
+            old_sv = owned_sv.get();
+        }
+    }
+    
 protected:
-    MoveValue(std::shared_ptr<const _NeighborhoodExplorer> ne, const SolutionValue& sv, const Move& mv, size_t size) : mv(mv), old_sv(sv), cs(sv.cs), ne(ne), std::vector<std::pair<bool, T>>(size, { false, 0 })
+    MoveValue(const _NeighborhoodExplorer* ne, const SolutionValue& sv, const Move& mv, size_t size) : cs(sv.cs.get()), ne(ne), mv(mv), old_sv(&sv), cache(size)
     {
         assert(sv.cs && ne);
     }
     
-    std::shared_ptr<const CostStructure> cs;
-    std::shared_ptr<const _NeighborhoodExplorer> ne;
-    Move mv;
-    SolutionValue old_sv;
-    mutable std::shared_ptr<Solution> new_sol;
+    void ComputeValues() const
+    {
+        for (size_t i = 0; i < this->size(); ++i)
+            (*this)[i];
+    }
+    
+    std::uint64_t WeightsEpoch() const
+    {
+        return old_sv->WeightsEpoch();
+    }
+    
+    /// Fills all the values from the transposition table of the cost structure, if the new solution is found there
+    /// (the table is looked up once per move value)
+    bool Transpose() const
+    {
+        if constexpr (has_hash_delta<_NeighborhoodExplorer> && requires { cs->GetTranspositionTable(); })
+        {
+            auto* table = cs->GetTranspositionTable();
+            if (!table || looked_up)
+                return false;
+            looked_up = true;
+            auto h = this->Hash();
+            if (!h)
+                return false;
+            thread_local std::vector<T> values;
+            values.resize(this->size());
+            if (!table->Load(*h, values))
+                return false;
+            for (size_t j = 0; j < values.size(); ++j)
+                cache.Set(j, values[j]);
+            transposed = true;
+            return true;
+        }
+        else
+            return false;
+    }
+    
+    /// Delta of the i-th component taken from the chunk of moves the move value has been created with, when the
+    /// neighborhood explorer evaluates it through a batched delta cost component
+    std::optional<T> BatchDelta(size_t i) const
+    {
+        if (!batch || !ne->HasBatchDeltaCostComponent(i, mv))
+            return std::nullopt;
+        return batch->Delta(i, batch_index, [this](size_t i, std::vector<T>& deltas, std::vector<bool>& evaluated) {
+            ne->ComputeBatchDeltaCosts(*old_sv, batch->Moves(), i, deltas, evaluated);
+        });
+    }
+    
+    /// Computes the value of the i-th component on the new solution
+    void ComputeFullCost(size_t i) const
+    {
+        if constexpr (has_undo_move<_NeighborhoodExplorer> || has_undo_token_move<_NeighborhoodExplorer>)
+        {
+            // rather than copying the whole solution, the move is applied in place to the scratch solution,
+            // then it is rolled back after the cost has been computed
+            if (!new_sol)
+            {
+                this->EvaluateInPlace([this, i](const Solution& scratch) { this->ComputeCost(scratch, i); });
+                return;
+            }
+        }
+        if (!new_sol)
+        {
+            // make a copy of the solution
+            new_sol = std::make_shared<Solution>(*(old_sv->GetSolution()));
+            // apply the move
+            ne->MakeMove(*new_sol, mv);
+        }
+        // compute the new cost directly from solution
+        this->ComputeCost(*new_sol, i);
+    }
+    
+    void ComputeCost(const Solution& sol, size_t i) const
+    {
+        if constexpr (requires { cs->ComputeCost(sol, i, cache); })
+            cs->ComputeCost(sol, i, cache);
+        else
+            cache.Set(i, cs->ComputeCost(sol, i));
+    }
+    
+    /// Computes the value of a block-decomposable component from the costs of the blocks touched by the move (as the
+    /// difference with the block costs stored in the state of the originating solution value), returns false if
+    /// either the component is not decomposable or the touched blocks are not known
+    bool ComputeBlockDelta(size_t i) const
+    {
+        if constexpr (has_touched_blocks<_NeighborhoodExplorer> && requires { cs->GetDecomposableCostComponent(i); })
+        {
+            const auto* dcc = cs->GetDecomposableCostComponent(i);
+            if (!dcc || !old_sv->GetState(i))
+                return false;
+            thread_local std::vector<size_t> blocks;
+            blocks.clear();
+            if (!ne->TouchedBlocks(*old_sv->GetSolution(), mv, i, blocks))
+                return false;
+            const auto& old_block_costs = old_sv->template GetState<std::vector<T>>(i);
+            T delta = 0;
+            auto compute_blocks = [&](const Solution& sol) {
+                for (size_t b : blocks)
+                    delta += dcc->ComputeBlockCost(sol, b) - old_block_costs[b];
+            };
+            if constexpr (has_undo_move<_NeighborhoodExplorer> || has_undo_token_move<_NeighborhoodExplorer>)
+            {
+                if (!new_sol)
+                    this->EvaluateInPlace(compute_blocks);
+                else
+                    compute_blocks(*new_sol);
+            }
+            else
+            {
+                this->GetSolution();
+                compute_blocks(*new_sol);
+            }
+            cache.Set(i, (*old_sv)[i] + delta);
+            return true;
+        }
+        else
+            return false;
+    }
+    
+    /// Recomputes, on the new solution, the block costs of a block-decomposable component touched by the move
+    bool UpdateBlockCosts(size_t i, CostComponentState& st) const
+    {
+        if constexpr (has_touched_blocks<_NeighborhoodExplorer> && requires { cs->GetDecomposableCostComponent(i); })
+        {
+            const auto* dcc = cs->GetDecomposableCostComponent(i);
+            std::vector<size_t> blocks;
+            if (!dcc || !ne->TouchedBlocks(*old_sv->GetSolution(), mv, i, blocks))
+                return false;
+            auto& block_costs = static_cast<CostComponentStateOf<std::vector<T>>&>(st).state;
+            for (size_t b : blocks)
+                block_costs[b] = dcc->ComputeBlockCost(*this->GetSolution(), b);
+            return true;
+        }
+        else
+            return false;
+    }
+    
+    /// Applies the move to the scratch solution of the thread, calls f on it and undoes the move
+    template <typename F>
+    void EvaluateInPlace(F&& f) const
+    {
+        const auto& source = old_sv->GetSolution();
+        auto& scratch = ScratchSolution<Solution>::Acquire(source);
+        // should anything go wrong, the scratch solution will be synced again at the next use
+        ScratchSolution<Solution>::Invalidate();
+        if constexpr (has_undo_token_move<_NeighborhoodExplorer>)
+        {
+            auto token = ne->MakeMove(scratch, mv);
+            f(scratch);
+            ne->UndoMove(scratch, mv, std::move(token));
+        }
+        else
+        {
+            ne->MakeMove(scratch, mv);
+            f(scratch);
+            ne->UndoMove(scratch, mv);
+        }
+        ScratchSolution<Solution>::Validate(source);
+    }
+    
+    /// States of the solution obtained by committing the move, updated incrementally by the stateful delta cost
+    /// components or rebuilt from the new solution otherwise
+    std::vector<std::shared_ptr<const CostComponentState>> ComputeStates() const
+    {
+        std::vector<std::shared_ptr<const CostComponentState>> states(old_sv->states.size());
+        for (size_t i = 0; i < states.size(); ++i)
+        {
+            if (!old_sv->states[i])
+                continue;
+            // states are immutable, hence the one of a component unaffected by the move is shared
+            if (!ne->Affects(*old_sv->GetSolution(), mv, i))
+            {
+                states[i] = old_sv->states[i];
+                continue;
+            }
+            auto st = old_sv->states[i]->Clone();
+            if (ne->UpdateState(i, *st, *old_sv->GetSolution(), mv))
+                states[i] = std::move(st);
+            else if (this->UpdateBlockCosts(i, *st))
+                states[i] = std::move(st);
+            else
+                states[i] = cs->CreateState(*this->GetSolution(), i);
+        }
+        return states;
+    }
+    
+    // non-owning references, to avoid reference counting for each evaluated move
+    const CostStructure* cs;
+    const _NeighborhoodExplorer* ne;
+    Move mv;
+    const SolutionValue* old_sv;
+    std::shared_ptr<const SolutionValue> owned_sv;
+    mutable std::shared_ptr<Solution> new_sol;
+    // move values are meant to be evaluated by a single thread, still they share the cache policy of the solution value
+    mutable typename SolutionValue::Cache cache;
+    mutable typename SolutionValue::CachePolicy::template Value<T> aggregated_cost;
+    // the chunk of moves the move value belongs to, if any, and its position there
+    std::shared_ptr<const MoveBatch<T, Move>> batch;
+    size_t batch_index = 0;
+    // whether the transposition table has been looked up, and whether the values have been found there
+    mutable bool looked_up = false, transposed = false;
+};
+
+/// Bookkeeping of the cost components shared by the cost structures whose components are added at runtime, the cost
+/// structure deriving from it (CostStructure) only adds how the values of the components are compared and aggregated
+template <InputT _Input, SolutionT<_Input> _Solution, Number _T, class _CachePolicy, class _CostStructure>
+class DynamicCostStructure : public std::enable_shared_from_this<_CostStructure>
+{
+public:
+    using Input = _Input;
+    using Solution = _Solution;
+    using T = _T;
+    /// Synchronization of the lazy caches of the solution and move values (see ConcurrentCachePolicy)
+    using CachePolicy = _CachePolicy;
+    using CostStructure = _CostStructure;
+    using SolutionValue = SolutionValue<Input, Solution, T, CostStructure>;
+    
+    template <CostComponentT<Input, Solution, T> CostComponent>
+    void AddCostComponent(std::shared_ptr<CostComponent> cc)
+    {
+        // make a copy of the cost component
+        cost_components.emplace_back(std::make_unique<CostComponent>(*cc));
+        fused_slots.emplace_back(nullptr);
+        if constexpr (std::derived_from<CostComponent, ChunkedCostComponent<Input, Solution, T>>)
+            chunked_components.emplace_back(static_cast<const CostComponent*>(cost_components.back().get()));
+        else
+            chunked_components.emplace_back(nullptr);
+        if constexpr (std::derived_from<CostComponent, DecomposableCostComponent<Input, Solution, T>>)
+        {
+            // the state of a decomposable cost component is made of its block costs
+            const auto* dcc = static_cast<const CostComponent*>(cost_components.back().get());
+            decomposable_components.emplace_back(dcc);
+            state_factories.emplace_back([dcc](const Solution& sol) -> std::shared_ptr<const CostComponentState> {
+                return std::make_shared<CostComponentStateOf<std::vector<T>>>(dcc->ComputeBlockCosts(sol));
+            });
+        }
+        else
+        {
+            decomposable_components.emplace_back(nullptr);
+            if constexpr (StatefulCostComponentT<CostComponent, Input, Solution, T>)
+                state_factories.emplace_back([](const Solution& sol) -> std::shared_ptr<const CostComponentState> {
+                    return std::make_shared<CostComponentStateOf<typename CostComponent::State>>(sol);
+                });
+            else
+                state_factories.emplace_back(nullptr);
+        }
+    }
+    
+    /// Adds the consecutive cost components computed by a fused cost component
+    template <FusedCostComponentT<Input, Solution, T> FusedCostComponent>
+    void AddFusedCostComponent(std::shared_ptr<FusedCostComponent> fcc)
+    {
+        // make a copy of the cost component, shared by the slots of its values
+        std::shared_ptr<const FusedCostComponent> p_fcc = std::make_shared<FusedCostComponent>(*fcc);
+        size_t first = cost_components.size();
+        for (size_t j = 0; j < p_fcc->Components(); ++j)
+        {
+            auto slot = std::make_unique<FusedCostComponentSlot<Input, Solution, T>>(p_fcc, first, j);
+            fused_slots.emplace_back(slot.get());
+            cost_components.emplace_back(std::move(slot));
+            state_factories.emplace_back(nullptr);
+            decomposable_components.emplace_back(nullptr);
+            chunked_components.emplace_back(nullptr);
+        }
+    }
+    
+    /// Evaluates the components of the new solution values at once, concurrently on the given pool (nullptr to go back
+    /// to lazy evaluation), chunked components being split in ranges of chunk_size elements
+    void SetParallelEvaluation(std::shared_ptr<ThreadPool> pool, size_t chunk_size = 1024)
+    {
+        assert(chunk_size > 0);
+        this->pool = pool;
+        this->chunk_size = chunk_size;
+    }
+    
+    /// Looks up the values of the new solution values in the table (nullptr to disable it) by the std::hash of their
+    /// solutions, the values of the solutions not found being computed at once and stored there; move values look up
+    /// the table as well, when the neighborhood explorer reports the hash delta of its moves (see has_hash_delta)
+    void SetTranspositionTable(std::shared_ptr<TranspositionTable<T>> table)
+    {
+        static_assert(std::is_default_constructible_v<std::hash<Solution>>, "A transposition table requires std::hash<Solution>");
+        assert(!table || table->Components() == cost_components.size());
+        transposition_table = table;
+    }
+    
+    TranspositionTable<T>* GetTranspositionTable() const
+    {
+        return transposition_table.get();
+    }
+    
+    SolutionValue CreateSolutionValue(std::shared_ptr<const Solution> sol) const
+    {
+        SolutionValue sv(this->shared_from_this(), sol, cost_components.size());
+        if (transposition_table)
+            sv.Transpose(*transposition_table);
+        else if (pool)
+            sv.SetValues(this->ComputeCosts(*sol));
+        return sv;
+    }
+    
+    T ComputeCost(const Solution& sol, size_t i) const
+    {
+        return this->cost_components[i]->ComputeCost(sol);
+    }
+    
+    /// Computes the values of all the components (in parallel, see SetParallelEvaluation)
+    std::vector<T> ComputeCosts(const Solution& sol) const
+    {
+        return ComputeAllCosts(pool.get(), chunk_size, sol, cost_components, fused_slots, chunked_components);
+    }
+    
+    /// Computes the i-th component into the cache, along with all the components fused with it
+    template <class Cache>
+    void ComputeCost(const Solution& sol, size_t i, Cache& cache) const
+    {
+        if (this->fused_slots[i])
+            this->fused_slots[i]->ComputeCosts(sol, cache);
+        else
+            cache.Set(i, this->cost_components[i]->ComputeCost(sol));
+    }
+    
+    bool HasStatefulComponents() const
+    {
+        return std::any_of(state_factories.begin(), state_factories.end(), [](const auto& f) { return f != nullptr; });
+    }
+    
+    /// Builds the state of the i-th cost component for the given solution (nullptr for stateless components)
+    std::shared_ptr<const CostComponentState> CreateState(const Solution& sol, size_t i) const
+    {
+        return this->state_factories[i] ? this->state_factories[i](sol) : nullptr;
+    }
+    
+    /// The i-th cost component, if it is block-decomposable (nullptr otherwise)
+    const DecomposableCostComponent<Input, Solution, T>* GetDecomposableCostComponent(size_t i) const
+    {
+        return this->decomposable_components[i];
+    }
+    
+    size_t Components() const
+    {
+        return this->cost_components.size();
+    }
+    
+protected:
+    std::vector<std::unique_ptr<CostComponent<Input, Solution, T>>> cost_components;
+    // non-owning pointers to the cost components which are slots of fused cost components (nullptr otherwise)
+    std::vector<const FusedCostComponentSlot<Input, Solution, T>*> fused_slots;
+    std::vector<std::function<std::shared_ptr<const CostComponentState>(const Solution&)>> state_factories;
+    std::vector<const DecomposableCostComponent<Input, Solution, T>*> decomposable_components;
+    std::vector<const ChunkedCostComponent<Input, Solution, T>*> chunked_components;
+    std::shared_ptr<ThreadPool> pool;
+    size_t chunk_size = 0;
+    std::shared_ptr<TranspositionTable<T>> transposition_table;
 };
 
-template <InputT _Input, SolutionT<_Input> _Solution, Number _T>
-class AggregatedCostStructure : public std::enable_shared_from_this<AggregatedCostStructure<_Input, _Solution, _T>>
+/// Converts a weight given as a floating-point number to an integral cost type, the weight must be an integer since
+/// it would be silently truncated otherwise
+template <std::integral T, std::floating_point W>
+T IntegralWeight(W weight)
+{
+    assert(weight == std::trunc(weight));
+    return static_cast<T>(weight);
+}
+
+template <InputT _Input, SolutionT<_Input> _Solution, Number _T, class _CachePolicy>
+class AggregatedCostStructure : public DynamicCostStructure<_Input, _Solution, _T, _CachePolicy, AggregatedCostStructure<_Input, _Solution, _T, _CachePolicy>>
 {
 public:
     using Input = _Input;
     using Solution = _Solution;
     using T = _T;
-    friend class SolutionValue<Input, Solution, T, AggregatedCostStructure<Input, Solution, T>>;
+    using CachePolicy = _CachePolicy;
+    friend class SolutionValue<Input, Solution, T, AggregatedCostStructure>;
+    template <InputT I, SolutionT<I> S, Number T_, CostStructureTd CS, class NE> friend class MoveValue;
     using SolutionValue = SolutionValue<Input, Solution, T, AggregatedCostStructure>;
 protected:
-    using SelfClass = AggregatedCostStructure<Input, Solution, T>;
+    using SelfClass = AggregatedCostStructure<Input, Solution, T, CachePolicy>;
     
 public:
     template <CostComponentT<Input, Solution, T> CostComponent>
-    void AddCostComponent(std::shared_ptr<CostComponent> cc, bool hard, double weight = 1.0)
+    void AddCostComponent(std::shared_ptr<CostComponent> cc, bool hard, T weight = 1)
     {
-        // make a copy of the cost component
-        cost_components.emplace_back(std::make_unique<CostComponent>(*cc));
+        assert(!pruning || weight >= 0);
+        DynamicCostStructure<Input, Solution, T, CachePolicy, SelfClass>::AddCostComponent(cc);
         hard_components.emplace_back(hard);
         weight_components.emplace_back(weight);
+        lower_bounds.emplace_back(0);
+        if (!custom_evaluation_order)
+            this->UpdateEvaluationOrder();
     }
     
-    SolutionValue CreateSolutionValue(std::shared_ptr<const Solution> sol) const
+    /// Floating-point weights are accepted by integral cost types only if they are integers (see IntegralWeight)
+    template <CostComponentT<Input, Solution, T> CostComponent, std::floating_point W>
+    requires std::integral<T>
+    void AddCostComponent(std::shared_ptr<CostComponent> cc, bool hard, W weight)
     {
-        return { this->shared_from_this(), sol, cost_components.size() };
+        this->AddCostComponent(cc, hard, IntegralWeight<T>(weight));
     }
     
-    T ComputeCost(std::shared_ptr<const Solution> sol, size_t i) const
+    /// Adds the consecutive cost components computed by a fused cost component, with their own hardness and weights
+    template <FusedCostComponentT<Input, Solution, T> FusedCostComponent>
+    void AddFusedCostComponent(std::shared_ptr<FusedCostComponent> fcc, const std::vector<bool>& hard, const std::vector<T>& weight = {})
     {
-        return this->cost_components[i]->ComputeCost(sol);
+        assert(hard.size() == fcc->Components() && (weight.empty() || weight.size() == fcc->Components()));
+        assert(!pruning || std::all_of(weight.begin(), weight.end(), [](T w) { return w >= 0; }));
+        DynamicCostStructure<Input, Solution, T, CachePolicy, SelfClass>::AddFusedCostComponent(fcc);
+        for (size_t j = 0; j < fcc->Components(); ++j)
+        {
+            hard_components.emplace_back(hard[j]);
+            weight_components.emplace_back(weight.empty() ? T(1) : weight[j]);
+            lower_bounds.emplace_back(0);
+        }
+        if (!custom_evaluation_order)
+            this->UpdateEvaluationOrder();
+    }
+    
+    /// Factor by which the weighted sum of the hard components is multiplied in the aggregated cost
+    void SetHardWeight(T hard_weight)
+    {
+        assert(!pruning || hard_weight >= 0);
+        HARD_WEIGHT = hard_weight;
+        weights_epoch++;
+    }
+    
+    template <std::floating_point W>
+    requires std::integral<T>
+    void SetHardWeight(W hard_weight)
+    {
+        this->SetHardWeight(IntegralWeight<T>(hard_weight));
+    }
+    
+    T GetHardWeight() const
+    {
+        return HARD_WEIGHT;
+    }
+    
+    /// Changes the weight of the i-th cost component (e.g., for strategic oscillation). The values of the components
+    /// cached by the existing solution and move values are still valid, only their aggregated costs are recomputed from
+    /// them at the next use. Weights must not be changed while values are being evaluated by other threads.
+    void SetWeight(size_t i, T weight)
+    {
+        assert(!pruning || weight >= 0);
+        weight_components[i] = weight;
+        weights_epoch++;
+    }
+    
+    template <std::floating_point W>
+    requires std::integral<T>
+    void SetWeight(size_t i, W weight)
+    {
+        this->SetWeight(i, IntegralWeight<T>(weight));
+    }
+    
+    T GetWeight(size_t i) const
+    {
+        return weight_components[i];
+    }
+    
+    /// Changes the hard/soft status of the i-th cost component (see SetWeight)
+    void SetHard(size_t i, bool hard)
+    {
+        hard_components[i] = hard;
+        weights_epoch++;
+        if (!custom_evaluation_order)
+            this->UpdateEvaluationOrder();
+    }
+    
+    bool IsHard(size_t i) const
+    {
+        return hard_components[i];
+    }
+    
+    /// Version of the weights, incremented at each change so that stale aggregated costs are detected
+    std::uint64_t WeightsEpoch() const
+    {
+        return weights_epoch;
+    }
+    
+    /// Lower bound of the values of the i-th cost component, used by bounded comparisons. Bounded comparisons prune
+    /// only once a lower bound or an evaluation order has been set (the bounds not set are zero, i.e., the costs of
+    /// those components are assumed non-negative) and pruning requires non-negative weights; otherwise they are plain
+    /// comparisons of the aggregated costs.
+    void SetLowerBound(size_t i, T lb)
+    {
+        lower_bounds[i] = lb;
+        this->EnablePruning();
+    }
+    
+    /// Order in which bounded comparisons evaluate the components (by default, hard components come first), it is
+    /// convenient to put first the components that are cheap to evaluate or that are likely to decide the comparison
+    /// (it enables pruning, see SetLowerBound)
+    void SetEvaluationOrder(const std::vector<size_t>& order)
+    {
+        assert(order.size() == this->cost_components.size());
+        evaluation_order = order;
+        custom_evaluation_order = true;
+        this->EnablePruning();
     }
     
     template <SolutionValueT<Input, Solution, T, SelfClass> SV1, SolutionValueT<Input, Solution, T, SelfClass> SV2>
     bool equality(const SV1& sc1, const SV2& sc2) const
     {
         assert(this->cost_components.size() == sc1.size() && this->cost_components.size() == sc2.size());
-        T total_cost_1 = this->ComputeAggregatedCost(sc1), total_cost_2 = this->ComputeAggregatedCost(sc2);
+        T total_cost_1 = sc1.AggregatedCost(), total_cost_2 = sc2.AggregatedCost();
         // TODO: consider floating point approximated equality at some point, use SFINAE
         return (total_cost_1 == total_cost_2);
     }
@@ -295,7 +1412,7 @@ public:
     std::strong_ordering spaceship(const SV1& sc1, const SV2& sc2) const
     {
         assert(this->cost_components.size() == sc1.size() && this->cost_components.size() == sc2.size());
-        T total_cost_1 = this->ComputeAggregatedCost(sc1), total_cost_2 = this->ComputeAggregatedCost(sc2);
+        T total_cost_1 = sc1.AggregatedCost(), total_cost_2 = sc2.AggregatedCost();
         // TODO: consider floating point approximated equality at some point, use SFINAE
         if (total_cost_1 < total_cost_2)
             return std::strong_ordering::less;
@@ -305,12 +1422,64 @@ public:
             return std::strong_ordering::greater;
     }
     
-    size_t Components() const
+    /// Evaluates the components of sc1 in the evaluation order and stops as soon as its partial aggregated cost,
+    /// completed with the lower bounds of the components not evaluated yet, is not less than the cost of sc2.
+    /// The lower bounds of the components are tightened by the cheap bounds of the deltas of sc1 (when it is a move value
+    /// whose delta cost components provide them), which may discard it before any exact evaluation.
+    /// Unless pruning has been enabled (see SetLowerBound), it is just the comparison of the aggregated costs.
+    template <SolutionValueT<Input, Solution, T, SelfClass> SV1, SolutionValueT<Input, Solution, T, SelfClass> SV2>
+    bool bounded_less(const SV1& sc1, const SV2& sc2) const
     {
-        return this->cost_components.size();
+        assert(this->cost_components.size() == sc1.size() && this->cost_components.size() == sc2.size());
+        if (!pruning)
+            return sc1.AggregatedCost() < sc2.AggregatedCost();
+        T bound = sc2.AggregatedCost();
+        thread_local std::vector<T> lb;
+        lb.assign(this->lower_bounds.begin(), this->lower_bounds.end());
+        T cost_H = 0, cost_S = 0;
+        for (size_t i = 0; i < this->cost_components.size(); ++i)
+        {
+            if constexpr (requires { sc1.LowerBound(i); })
+                if (auto b = sc1.LowerBound(i); b && *b > lb[i])
+                    lb[i] = *b;
+            if (this->hard_components[i])
+                cost_H += this->weight_components[i] * lb[i];
+            else
+                cost_S += this->weight_components[i] * lb[i];
+        }
+        if (this->HARD_WEIGHT * cost_H + cost_S >= bound)
+            return false;
+        for (size_t i : this->evaluation_order)
+        {
+            if (this->hard_components[i])
+                cost_H += this->weight_components[i] * (sc1[i] - lb[i]);
+            else
+                cost_S += this->weight_components[i] * (sc1[i] - lb[i]);
+            if (this->HARD_WEIGHT * cost_H + cost_S >= bound)
+                return false;
+        }
+        return sc1.AggregatedCost() < bound;
     }
     
 protected:
+    /// With negative weights, the weighted lower bounds would not bound the aggregated cost from below
+    void EnablePruning()
+    {
+        assert(HARD_WEIGHT >= 0 && std::all_of(weight_components.begin(), weight_components.end(), [](T w) { return w >= 0; }));
+        pruning = true;
+    }
+    
+    void UpdateEvaluationOrder()
+    {
+        evaluation_order.clear();
+        for (size_t i = 0; i < this->cost_components.size(); ++i)
+            if (hard_components[i])
+                evaluation_order.push_back(i);
+        for (size_t i = 0; i < this->cost_components.size(); ++i)
+            if (!hard_components[i])
+                evaluation_order.push_back(i);
+    }
+    
     template <SolutionValueT<Input, Solution, T, SelfClass> SV>
     T ComputeAggregatedCost(const SV& sv) const
     {
@@ -325,45 +1494,373 @@ protected:
         return this->HARD_WEIGHT * cost_H + cost_S;
     }
     
-    std::vector<std::unique_ptr<CostComponent<Input, Solution, T>>> cost_components;
+    // weighted difference between the aggregated costs of sv and base, components whose value is unchanged do not contribute
+    template <SolutionValueT<Input, Solution, T, SelfClass> SV1, SolutionValueT<Input, Solution, T, SelfClass> SV2>
+    T ComputeAggregatedDelta(const SV1& sv, const SV2& base) const
+    {
+        T delta_H = 0, delta_S = 0;
+        for (size_t i = 0; i < this->cost_components.size(); ++i)
+        {
+            T delta = sv[i] - base[i];
+            if (delta == 0)
+                continue;
+            if (this->hard_components[i])
+                delta_H += this->weight_components[i] * delta;
+            else
+                delta_S += this->weight_components[i] * delta;
+        }
+        return this->HARD_WEIGHT * delta_H + delta_S;
+    }
+    
     std::vector<bool> hard_components;
-    std::vector<double> weight_components;
+    // weights have the same type of the costs, so that integer costs are aggregated with integer arithmetic only
+    std::vector<T> weight_components;
+    std::vector<T> lower_bounds;
+    std::vector<size_t> evaluation_order;
+    bool custom_evaluation_order = false;
+    // whether bounded comparisons prune, see SetLowerBound
+    bool pruning = false;
     T HARD_WEIGHT = 1000;
+    std::uint64_t weights_epoch = 0;
 };
 
-template <InputT _Input, SolutionT<_Input> _Solution, Number _T>
-class MultiObjectiveCostStructure : public std::enable_shared_from_this<MultiObjectiveCostStructure<_Input, _Solution, _T>>
+/// Fixes at compile time the weight and the hardness of a cost component of a StaticAggregatedCostStructure, so that
+/// its contribution to the aggregated cost is a constant-folded product
+template <class CostComponent, auto _weight, bool _hard = false>
+class FixedWeight : public CostComponent
+{
+public:
+    using CostComponent::CostComponent;
+    static constexpr auto weight = _weight;
+    static constexpr bool hard = _hard;
+};
+
+/// Compile-time counterpart of AggregatedCostStructure: the cost components are stored by value in a tuple,
+/// so that their ComputeCost is statically bound and can be inlined. The i-th component is reached through a
+/// constexpr jump table, hence ComputeCost(sol, i) costs a single indirect call to a fully specialized function.
+template <InputT _Input, SolutionT<_Input> _Solution, Number _T, CostComponentT<_Input, _Solution, _T> ...CostComponents>
+class StaticAggregatedCostStructure : public std::enable_shared_from_this<StaticAggregatedCostStructure<_Input, _Solution, _T, CostComponents...>>
 {
 public:
     using Input = _Input;
     using Solution = _Solution;
     using T = _T;
-    friend class SolutionValue<Input, Solution, T, MultiObjectiveCostStructure<Input, Solution, T>>;
-    using SolutionValue = SolutionValue<Input, Solution, T, MultiObjectiveCostStructure>;
-    using SelfClass = MultiObjectiveCostStructure<_Input, _Solution, _T>;
-    
-    template <CostComponentT<Input, Solution, T> CostComponent>
-    void AddCostComponent(std::shared_ptr<CostComponent> cc)
+    friend class SolutionValue<Input, Solution, T, StaticAggregatedCostStructure<Input, Solution, T, CostComponents...>>;
+    template <InputT I, SolutionT<I> S, Number T_, CostStructureTd CS, class NE> friend class MoveValue;
+    using SolutionValue = SolutionValue<Input, Solution, T, StaticAggregatedCostStructure>;
+protected:
+    using SelfClass = StaticAggregatedCostStructure<Input, Solution, T, CostComponents...>;
+    static constexpr size_t components = sizeof...(CostComponents);
+
+public:
+    /// Sets the hard/soft status and the weight of the i-th (default constructed) cost component
+    template <size_t i>
+    void SetCostComponent(bool hard, T weight = 1)
+    {
+        static_assert(i < components, "Cost component index out of range");
+        static_assert(!has_fixed_weight<std::tuple_element_t<i, std::tuple<CostComponents...>>>, "The weight of the cost component is fixed at compile time");
+        assert(!pruning || weight >= 0);
+        hard_components[i] = hard;
+        weight_components[i] = weight;
+        // the aggregated costs cached by the existing values are recomputed from their component values
+        weights_epoch++;
+        if (!custom_evaluation_order)
+            this->UpdateEvaluationOrder();
+    }
+
+    template <size_t i>
+    void SetCostComponent(std::shared_ptr<std::tuple_element_t<i, std::tuple<CostComponents...>>> cc, bool hard, T weight = 1)
     {
         // make a copy of the cost component
-        cost_components.emplace_back(std::make_unique<CostComponent>(*cc));
+        std::get<i>(cost_components) = *cc;
+        this->SetCostComponent<i>(hard, weight);
     }
-    
+
+    /// Floating-point weights are accepted by integral cost types only if they are integers (see IntegralWeight)
+    template <size_t i, std::floating_point W>
+    requires std::integral<T>
+    void SetCostComponent(bool hard, W weight)
+    {
+        this->SetCostComponent<i>(hard, IntegralWeight<T>(weight));
+    }
+
+    template <size_t i, std::floating_point W>
+    requires std::integral<T>
+    void SetCostComponent(std::shared_ptr<std::tuple_element_t<i, std::tuple<CostComponents...>>> cc, bool hard, W weight)
+    {
+        this->SetCostComponent<i>(cc, hard, IntegralWeight<T>(weight));
+    }
+
+    /// Replaces the i-th cost component, keeping its hard/soft status and its weight
+    template <size_t i>
+    void SetCostComponent(std::shared_ptr<std::tuple_element_t<i, std::tuple<CostComponents...>>> cc)
+    {
+        std::get<i>(cost_components) = *cc;
+    }
+
+    template <size_t i>
+    const auto& GetCostComponent() const
+    {
+        return std::get<i>(cost_components);
+    }
+
+    /// Factor by which the weighted sum of the hard components is multiplied in the aggregated cost
+    void SetHardWeight(T hard_weight)
+    {
+        assert(!pruning || hard_weight >= 0);
+        HARD_WEIGHT = hard_weight;
+        weights_epoch++;
+    }
+
+    template <std::floating_point W>
+    requires std::integral<T>
+    void SetHardWeight(W hard_weight)
+    {
+        this->SetHardWeight(IntegralWeight<T>(hard_weight));
+    }
+
+    T GetHardWeight() const
+    {
+        return HARD_WEIGHT;
+    }
+
+    /// See AggregatedCostStructure::WeightsEpoch
+    std::uint64_t WeightsEpoch() const
+    {
+        return weights_epoch;
+    }
+
+    /// See AggregatedCostStructure::SetLowerBound
+    void SetLowerBound(size_t i, T lb)
+    {
+        lower_bounds[i] = lb;
+        this->EnablePruning();
+    }
+
+    /// Order in which bounded comparisons evaluate the components (by default, hard components come first), it enables
+    /// pruning as well
+    void SetEvaluationOrder(const std::array<size_t, components>& order)
+    {
+        evaluation_order = order;
+        custom_evaluation_order = true;
+        this->EnablePruning();
+    }
+
     SolutionValue CreateSolutionValue(std::shared_ptr<const Solution> sol) const
     {
-        return { this->shared_from_this(), sol, cost_components.size() };
+        return { this->shared_from_this(), sol, components };
     }
-    
-    T ComputeCost(std::shared_ptr<const Solution> sol, size_t i) const
+
+    T ComputeCost(const Solution& sol, size_t i) const
     {
-        return this->cost_components[i]->ComputeCost(sol);
+        static constexpr auto compute_cost = []<size_t ...I>(std::index_sequence<I...>) {
+            return std::array<T (*)(const SelfClass&, const Solution&), components>{ &SelfClass::ComputeCostOf<I>... };
+        }(std::index_sequence_for<CostComponents...>{});
+        assert(i < components);
+        return compute_cost[i](*this, sol);
+    }
+
+    constexpr bool HasStatefulComponents() const
+    {
+        return (StatefulCostComponentT<CostComponents, Input, Solution, T> || ...);
+    }
+
+    /// Builds the state of the i-th cost component for the given solution (nullptr for stateless components)
+    std::shared_ptr<const CostComponentState> CreateState(const Solution& sol, size_t i) const
+    {
+        static constexpr auto create_state = []<size_t ...I>(std::index_sequence<I...>) {
+            return std::array<std::shared_ptr<const CostComponentState> (*)(const Solution&), components>{ &SelfClass::CreateStateOf<I>... };
+        }(std::index_sequence_for<CostComponents...>{});
+        assert(i < components);
+        return create_state[i](sol);
+    }
+
+    template <SolutionValueT<Input, Solution, T, SelfClass> SV1, SolutionValueT<Input, Solution, T, SelfClass> SV2>
+    bool equality(const SV1& sc1, const SV2& sc2) const
+    {
+        assert(components == sc1.size() && components == sc2.size());
+        // TODO: consider floating point approximated equality at some point, use SFINAE
+        return sc1.AggregatedCost() == sc2.AggregatedCost();
     }
+
+    template <SolutionValueT<Input, Solution, T, SelfClass> SV1, SolutionValueT<Input, Solution, T, SelfClass> SV2>
+    std::strong_ordering spaceship(const SV1& sc1, const SV2& sc2) const
+    {
+        assert(components == sc1.size() && components == sc2.size());
+        T total_cost_1 = sc1.AggregatedCost(), total_cost_2 = sc2.AggregatedCost();
+        // TODO: consider floating point approximated equality at some point, use SFINAE
+        if (total_cost_1 < total_cost_2)
+            return std::strong_ordering::less;
+        else if (total_cost_1 == total_cost_2)
+            return std::strong_ordering::equal;
+        else
+            return std::strong_ordering::greater;
+    }
+
+    /// See AggregatedCostStructure::bounded_less
+    template <SolutionValueT<Input, Solution, T, SelfClass> SV1, SolutionValueT<Input, Solution, T, SelfClass> SV2>
+    bool bounded_less(const SV1& sc1, const SV2& sc2) const
+    {
+        assert(components == sc1.size() && components == sc2.size());
+        if (!pruning)
+            return sc1.AggregatedCost() < sc2.AggregatedCost();
+        T bound = sc2.AggregatedCost();
+        std::array<T, components> lb = this->lower_bounds;
+        T cost_H = 0, cost_S = 0;
+        for (size_t i = 0; i < components; ++i)
+        {
+            if constexpr (requires { sc1.LowerBound(i); })
+                if (auto b = sc1.LowerBound(i); b && *b > lb[i])
+                    lb[i] = *b;
+            (this->hard_components[i] ? cost_H : cost_S) += this->weight_components[i] * lb[i];
+        }
+        if (this->HARD_WEIGHT * cost_H + cost_S >= bound)
+            return false;
+        for (size_t i : this->evaluation_order)
+        {
+            (this->hard_components[i] ? cost_H : cost_S) += this->weight_components[i] * (sc1[i] - lb[i]);
+            if (this->HARD_WEIGHT * cost_H + cost_S >= bound)
+                return false;
+        }
+        return sc1.AggregatedCost() < bound;
+    }
+
+    size_t Components() const
+    {
+        return components;
+    }
+
+protected:
+    /// See AggregatedCostStructure::EnablePruning
+    void EnablePruning()
+    {
+        assert(HARD_WEIGHT >= 0 && std::all_of(weight_components.begin(), weight_components.end(), [](T w) { return w >= 0; }));
+        pruning = true;
+    }
+
+    void UpdateEvaluationOrder()
+    {
+        std::iota(evaluation_order.begin(), evaluation_order.end(), 0);
+        std::stable_partition(evaluation_order.begin(), evaluation_order.end(), [this](size_t i) { return this->hard_components[i]; });
+    }
+
+    template <size_t i>
+    static T ComputeCostOf(const SelfClass& cs, const Solution& sol)
+    {
+        using CostComponent = std::tuple_element_t<i, std::tuple<CostComponents...>>;
+        // the qualified call prevents virtual dispatch in case the component derives from CostComponent
+        return std::get<i>(cs.cost_components).CostComponent::ComputeCost(sol);
+    }
+
+    template <size_t i>
+    static std::shared_ptr<const CostComponentState> CreateStateOf(const Solution& sol)
+    {
+        using CostComponent = std::tuple_element_t<i, std::tuple<CostComponents...>>;
+        if constexpr (StatefulCostComponentT<CostComponent, Input, Solution, T>)
+            return std::make_shared<CostComponentStateOf<typename CostComponent::State>>(sol);
+        else
+            return nullptr;
+    }
+
+    /// Adds the weighted value of the i-th component to either the hard or the soft cost, with compile-time weights
+    /// the branch is resolved and the multiplication constant-folded
+    template <size_t i>
+    void AddWeighted(T& cost_H, T& cost_S, T value) const
+    {
+        using CostComponent = std::tuple_element_t<i, std::tuple<CostComponents...>>;
+        if constexpr (has_fixed_weight<CostComponent>)
+        {
+            if constexpr (CostComponent::hard)
+                cost_H += T(CostComponent::weight) * value;
+            else
+                cost_S += T(CostComponent::weight) * value;
+        }
+        else
+            (this->hard_components[i] ? cost_H : cost_S) += this->weight_components[i] * value;
+    }
+
+    template <SolutionValueT<Input, Solution, T, SelfClass> SV>
+    T ComputeAggregatedCost(const SV& sv) const
+    {
+        T cost_H = 0, cost_S = 0;
+        [&]<size_t ...I>(std::index_sequence<I...>) {
+            (this->AddWeighted<I>(cost_H, cost_S, sv[I]), ...);
+        }(std::index_sequence_for<CostComponents...>{});
+        return this->HARD_WEIGHT * cost_H + cost_S;
+    }
+
+    template <SolutionValueT<Input, Solution, T, SelfClass> SV1, SolutionValueT<Input, Solution, T, SelfClass> SV2>
+    T ComputeAggregatedDelta(const SV1& sv, const SV2& base) const
+    {
+        T delta_H = 0, delta_S = 0;
+        [&]<size_t ...I>(std::index_sequence<I...>) {
+            (this->AddWeighted<I>(delta_H, delta_S, sv[I] - base[I]), ...);
+        }(std::index_sequence_for<CostComponents...>{});
+        return this->HARD_WEIGHT * delta_H + delta_S;
+    }
+
+    template <class CostComponent>
+    static constexpr bool DefaultHard()
+    {
+        if constexpr (has_fixed_weight<CostComponent>)
+            return CostComponent::hard;
+        else
+            return false;
+    }
+
+    template <class CostComponent>
+    static constexpr T DefaultWeight()
+    {
+        if constexpr (has_fixed_weight<CostComponent>)
+            return T(CostComponent::weight);
+        else
+            return T(1);
+    }
+
+    std::tuple<CostComponents...> cost_components;
+    // the arrays also hold the compile-time weights, which are used by the comparisons evaluating components by index
+    std::array<bool, components> hard_components{ DefaultHard<CostComponents>()... };
+    std::array<T, components> weight_components{ DefaultWeight<CostComponents>()... };
+    std::array<T, components> lower_bounds{};
+    std::array<size_t, components> evaluation_order = []() {
+        // hard components first
+        constexpr std::array<bool, components> hard{ DefaultHard<CostComponents>()... };
+        std::array<size_t, components> order{};
+        size_t k = 0;
+        for (size_t i = 0; i < components; ++i)
+            if (hard[i])
+                order[k++] = i;
+        for (size_t i = 0; i < components; ++i)
+            if (!hard[i])
+                order[k++] = i;
+        return order;
+    }();
+    bool custom_evaluation_order = false;
+    // whether bounded comparisons prune, see AggregatedCostStructure::SetLowerBound
+    bool pruning = false;
+    T HARD_WEIGHT = 1000;
+    std::uint64_t weights_epoch = 0;
+};
+
+template <InputT _Input, SolutionT<_Input> _Solution, Number _T, class _CachePolicy = SequentialCachePolicy>
+class MultiObjectiveCostStructure : public DynamicCostStructure<_Input, _Solution, _T, _CachePolicy, MultiObjectiveCostStructure<_Input, _Solution, _T, _CachePolicy>>
+{
+public:
+    using Input = _Input;
+    using Solution = _Solution;
+    using T = _T;
+    using CachePolicy = _CachePolicy;
+    friend class SolutionValue<Input, Solution, T, MultiObjectiveCostStructure>;
+    using SolutionValue = SolutionValue<Input, Solution, T, MultiObjectiveCostStructure>;
+    using SelfClass = MultiObjectiveCostStructure<_Input, _Solution, _T, _CachePolicy>;
     
     template <SolutionValueT<Input, Solution, T, SelfClass> SV1, SolutionValueT<Input, Solution, T, SelfClass> SV2>
     bool equality(const SV1& sc1, const SV2& sc2) const
     {
         assert(this->cost_components.size() == sc1.size() && this->cost_components.size() == sc2.size());
         
+        if (const T *values_1 = sc1.ComputedValues(), *values_2 = sc2.ComputedValues(); values_1 && values_2)
+            return CompareCostVectors(values_1, values_2, this->cost_components.size()) == CostVectorComparison::equal;
         // TODO: consider floating point approximated equality at some point, use SFINAE
         for (size_t i = 0; i < this->cost_components.size(); ++i)
         {
@@ -377,6 +1874,10 @@ public:
     std::partial_ordering spaceship(const SV1& sc1, const SV2& sc2) const
     {
         assert(this->cost_components.size() == sc1.size() && this->cost_components.size() == sc2.size());
+        // fully evaluated values are compared a vector register at a time, otherwise components are computed lazily
+        // until the values turn out to be incomparable
+        if (const T *values_1 = sc1.ComputedValues(), *values_2 = sc2.ComputedValues(); values_1 && values_2)
+            return CompareDominance(values_1, values_2, this->cost_components.size());
         size_t sc1_less_than_sc2 = 0, sc1_greater_than_sc2 = 0;
         for (size_t i = 0; i < this->cost_components.size(); ++i)
         {
@@ -401,13 +1902,47 @@ public:
             return std::partial_ordering::equivalent;
         return std::partial_ordering::unordered;
     }
+};
+
+/// Compares the cost components one at a time in priority order (the order in which they are added), so that
+/// lower-priority components are computed only when all the higher-priority ones are tied
+template <InputT _Input, SolutionT<_Input> _Solution, Number _T, class _CachePolicy = SequentialCachePolicy>
+class LexicographicCostStructure : public DynamicCostStructure<_Input, _Solution, _T, _CachePolicy, LexicographicCostStructure<_Input, _Solution, _T, _CachePolicy>>
+{
+public:
+    using Input = _Input;
+    using Solution = _Solution;
+    using T = _T;
+    using CachePolicy = _CachePolicy;
+    friend class SolutionValue<Input, Solution, T, LexicographicCostStructure>;
+    using SolutionValue = SolutionValue<Input, Solution, T, LexicographicCostStructure>;
+    using SelfClass = LexicographicCostStructure<_Input, _Solution, _T, _CachePolicy>;
     
-    size_t Components() const
+    template <SolutionValueT<Input, Solution, T, SelfClass> SV1, SolutionValueT<Input, Solution, T, SelfClass> SV2>
+    bool equality(const SV1& sc1, const SV2& sc2) const
     {
-        return this->cost_components.size();
+        assert(this->cost_components.size() == sc1.size() && this->cost_components.size() == sc2.size());
+        
+        for (size_t i = 0; i < this->cost_components.size(); ++i)
+        {
+            if (sc1[i] != sc2[i])
+                return false;
+        }
+        return true;
     }
     
-protected:
-    std::vector<std::unique_ptr<CostComponent<Input, Solution, T>>> cost_components;
+    template <SolutionValueT<Input, Solution, T, SelfClass> SV1, SolutionValueT<Input, Solution, T, SelfClass> SV2>
+    auto spaceship(const SV1& sc1, const SV2& sc2) const -> std::compare_three_way_result_t<T>
+    {
+        assert(this->cost_components.size() == sc1.size() && this->cost_components.size() == sc2.size());
+        // components are accessed lazily, hence the first one which is not tied decides without computing the others
+        for (size_t i = 0; i < this->cost_components.size(); ++i)
+        {
+            auto c = sc1[i] <=> sc2[i];
+            if (c != 0)
+                return c;
+        }
+        return std::compare_three_way_result_t<T>::equivalent;
+    }
 };
 }
@@ -0,0 +1,126 @@
+//
+//  dominance.hh
+//  easylocal
+//
+//  Branch-free comparison kernels for vectors of cost component values (all components are minimized).
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <compare>
+#include <type_traits>
+#include "concepts.hh"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace easylocal {
+
+  /// Outcome of the comparison of two cost vectors a and b, as a mask
+  struct CostVectorComparison
+  {
+    enum : unsigned
+    {
+      equal = 0,
+      less = 1,     // some component of a is lower than the one of b
+      greater = 2,  // some component of a is greater than the one of b
+      incomparable = less | greater
+    };
+  };
+
+  /// Compares the n components of the cost vectors a and b, stopping as soon as they turn out to be incomparable.
+  /// Components are compared a vector register at a time (with SSE2/AVX2 for int and double, and with loops that
+  /// compilers vectorize for the other types), the outcomes being accumulated in a mask without branches.
+  template <Number T>
+  unsigned CompareCostVectors(const T* a, const T* b, size_t n)
+  {
+    using C = CostVectorComparison;
+    unsigned mask = C::equal;
+    size_t k = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+    if constexpr (std::is_same_v<T, std::int32_t>)
+    {
+#if defined(__AVX2__)
+      for (; k + 8 <= n && mask != C::incomparable; k += 8)
+      {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + k)), vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + k));
+        mask |= (_mm256_movemask_epi8(_mm256_cmpgt_epi32(vb, va)) != 0 ? C::less : C::equal) | (_mm256_movemask_epi8(_mm256_cmpgt_epi32(va, vb)) != 0 ? C::greater : C::equal);
+      }
+#endif
+      for (; k + 4 <= n && mask != C::incomparable; k += 4)
+      {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + k)), vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + k));
+        mask |= (_mm_movemask_epi8(_mm_cmplt_epi32(va, vb)) != 0 ? C::less : C::equal) | (_mm_movemask_epi8(_mm_cmpgt_epi32(va, vb)) != 0 ? C::greater : C::equal);
+      }
+    }
+    else if constexpr (std::is_same_v<T, double>)
+    {
+#if defined(__AVX__)
+      for (; k + 4 <= n && mask != C::incomparable; k += 4)
+      {
+        __m256d va = _mm256_loadu_pd(a + k), vb = _mm256_loadu_pd(b + k);
+        mask |= (_mm256_movemask_pd(_mm256_cmp_pd(va, vb, _CMP_LT_OQ)) != 0 ? C::less : C::equal) | (_mm256_movemask_pd(_mm256_cmp_pd(va, vb, _CMP_GT_OQ)) != 0 ? C::greater : C::equal);
+      }
+#endif
+      for (; k + 2 <= n && mask != C::incomparable; k += 2)
+      {
+        __m128d va = _mm_loadu_pd(a + k), vb = _mm_loadu_pd(b + k);
+        mask |= (_mm_movemask_pd(_mm_cmplt_pd(va, vb)) != 0 ? C::less : C::equal) | (_mm_movemask_pd(_mm_cmpgt_pd(va, vb)) != 0 ? C::greater : C::equal);
+      }
+    }
+    else
+#endif
+    {
+      // blocks as wide as a 256-bit register, whose inner loop has no branches
+      constexpr size_t block = sizeof(T) < 32 ? 32 / sizeof(T) : 1;
+      for (; k + block <= n && mask != C::incomparable; k += block)
+      {
+        unsigned less = 0, greater = 0;
+        for (size_t j = 0; j < block; ++j)
+        {
+          less |= unsigned(a[k + j] < b[k + j]);
+          greater |= unsigned(a[k + j] > b[k + j]);
+        }
+        mask |= less | (greater << 1);
+      }
+    }
+    for (; k < n && mask != C::incomparable; ++k)
+      mask |= unsigned(a[k] < b[k]) | (unsigned(a[k] > b[k]) << 1);
+    return mask;
+  }
+
+  /// Pareto ordering of the cost vectors a and b (less means that a dominates b)
+  template <Number T>
+  std::partial_ordering CompareDominance(const T* a, const T* b, size_t n)
+  {
+    using C = CostVectorComparison;
+    switch (CompareCostVectors(a, b, n))
+    {
+      case C::equal:
+        return std::partial_ordering::equivalent;
+      case C::less:
+        return std::partial_ordering::less;
+      case C::greater:
+        return std::partial_ordering::greater;
+      default:
+        return std::partial_ordering::unordered;
+    }
+  }
+
+  /// Whether a dominates b, i.e., a is not worse on any component and better on at least one
+  template <Number T>
+  bool Dominates(const T* a, const T* b, size_t n)
+  {
+    return CompareCostVectors(a, b, n) == CostVectorComparison::less;
+  }
+
+  /// Whether a is not worse than b on any component
+  template <Number T>
+  bool WeaklyDominates(const T* a, const T* b, size_t n)
+  {
+    return (CompareCostVectors(a, b, n) & CostVectorComparison::greater) == 0;
+  }
+}
@@ -0,0 +1,169 @@
+//
+//  evaluation-autotuner.hh
+//  easylocal
+//
+//  Runtime choice between delta and full evaluation of the cost components, based on their measured timings.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <optional>
+
+namespace easylocal {
+
+  /// How the value of a cost component is obtained for a move: from the value of the originating solution plus the
+  /// delta computed by the delta cost component, or from the cost of the new solution (copied or modified in place)
+  enum class EvaluationStrategy : std::uint8_t { Delta, Full };
+
+  /// Times the evaluation of each cost component through both strategies during a warm-up, then settles on the faster
+  /// one. The faster choice depends on the instance (e.g., a complex delta may be slower than a full evaluation on small
+  /// solutions), hence it is made at runtime. Until a component is decided, its evaluations alternate between the two
+  /// strategies so that both get the same number of samples. Selecting the strategy never locks, only recording the
+  /// timings during the warm-up does. A full evaluation is timed on the new solution, excluding the application of the
+  /// move, which is the same whether the move is applied in place or on a copy of the solution.
+  /// Autotuning is disabled (i.e., deltas are always used) unless a warm-up length is set.
+  class EvaluationAutotuner
+  {
+  public:
+    struct Timings
+    {
+      size_t delta_samples = 0, full_samples = 0;
+      std::chrono::nanoseconds delta_time{ 0 }, full_time{ 0 };
+      /// The strategy chosen at the end of the warm-up, if it has ended
+      std::optional<EvaluationStrategy> choice;
+
+      double MeanDeltaTime() const
+      {
+        return delta_samples > 0 ? double(delta_time.count()) / delta_samples : 0.0;
+      }
+
+      double MeanFullTime() const
+      {
+        return full_samples > 0 ? double(full_time.count()) / full_samples : 0.0;
+      }
+    };
+
+    /// The strategy for the next evaluation of a component, and whether it has to be timed
+    struct Selection
+    {
+      EvaluationStrategy strategy;
+      bool timed;
+    };
+
+    EvaluationAutotuner() = default;
+
+    EvaluationAutotuner(const EvaluationAutotuner& other)
+    {
+      std::lock_guard<std::mutex> lock(other.mutex);
+      warmup = other.warmup;
+      timings = other.timings;
+      this->AllocateChoices(timings.size());
+      for (size_t i = 0; i < timings.size(); ++i)
+      {
+        choices[i].store(other.choices[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        balances[i].store(other.balances[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+    }
+
+    void Resize(size_t components)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      timings.assign(components, Timings());
+      this->AllocateChoices(components);
+    }
+
+    /// Number of timed evaluations per strategy before choosing one (zero disables autotuning), it restarts the warm-up
+    void SetWarmup(size_t samples)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      warmup = samples;
+      timings.assign(timings.size(), Timings());
+      for (size_t i = 0; i < timings.size(); ++i)
+      {
+        choices[i].store(undecided, std::memory_order_relaxed);
+        balances[i].store(0, std::memory_order_relaxed);
+      }
+    }
+
+    size_t GetWarmup() const
+    {
+      return warmup;
+    }
+
+    Selection Select(size_t i) const
+    {
+      if (warmup == 0)
+        return { EvaluationStrategy::Delta, false };
+      if (auto c = choices[i].load(std::memory_order_acquire); c != undecided)
+        return { EvaluationStrategy(c), false };
+      // the strategy lagging behind gets the next sample (concurrent evaluations may pick the same one, which is harmless)
+      return { balances[i].load(std::memory_order_relaxed) > 0 ? EvaluationStrategy::Full : EvaluationStrategy::Delta, true };
+    }
+
+    /// Records the time taken by samples evaluations of the i-th component (more than one when they are done at once,
+    /// e.g., by a batched delta cost component)
+    void Record(size_t i, EvaluationStrategy strategy, std::chrono::nanoseconds elapsed, size_t samples = 1)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto& t = timings[i];
+      if (t.choice)
+        return;
+      if (strategy == EvaluationStrategy::Delta)
+      {
+        t.delta_samples += samples;
+        t.delta_time += elapsed;
+      }
+      else
+      {
+        t.full_samples += samples;
+        t.full_time += elapsed;
+      }
+      balances[i].store(std::int64_t(t.delta_samples) - std::int64_t(t.full_samples), std::memory_order_relaxed);
+      if (t.delta_samples >= warmup && t.full_samples >= warmup)
+      {
+        t.choice = t.MeanFullTime() < t.MeanDeltaTime() ? EvaluationStrategy::Full : EvaluationStrategy::Delta;
+        choices[i].store(std::uint8_t(*t.choice), std::memory_order_release);
+      }
+    }
+
+    /// The strategy used for the component (Delta while warming up)
+    EvaluationStrategy GetStrategy(size_t i) const
+    {
+      auto c = choices[i].load(std::memory_order_acquire);
+      return c != undecided ? EvaluationStrategy(c) : EvaluationStrategy::Delta;
+    }
+
+    Timings GetTimings(size_t i) const
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      return timings[i];
+    }
+
+  protected:
+    void AllocateChoices(size_t components)
+    {
+      choices = std::make_unique<std::atomic<std::uint8_t>[]>(components);
+      balances = std::make_unique<std::atomic<std::int64_t>[]>(components);
+      for (size_t i = 0; i < components; ++i)
+      {
+        choices[i].store(undecided, std::memory_order_relaxed);
+        balances[i].store(0, std::memory_order_relaxed);
+      }
+    }
+
+    static constexpr std::uint8_t undecided = 0xff;
+    size_t warmup = 0;
+    std::vector<Timings> timings;
+    std::unique_ptr<std::atomic<std::uint8_t>[]> choices;
+    // delta samples minus full samples of each component during the warm-up, read by Select without locking
+    std::unique_ptr<std::atomic<std::int64_t>[]> balances;
+    mutable std::mutex mutex;
+  };
+}
@@ -108,13 +108,21 @@ protected:
             
             if (accept_move.accept(this))
             {
-                // make move
+                // make move, the move value refers to the current solution value, which is going to be replaced
+                current_move_value->Detach();
                 *current_solution_value = *current_move_value;
                 idle_iteration = 0;
                 std::ostringstream oss;
                 oss << (*(current_solution_value->GetSolution()));
                 // std::cout << oss.str() << std::endl;
-                spdlog::info("{} --> {}", oss.str(), current_solution_value->AggregatedCost());
+                if constexpr (requires { current_solution_value->AggregatedCost(); })
+                    spdlog::info("{} --> {}", oss.str(), current_solution_value->AggregatedCost());
+                else
+                {
+                    std::ostringstream oss_value;
+                    oss_value << *current_solution_value;
+                    spdlog::info("{} --> {}", oss.str(), oss_value.str());
+                }
             }
             else
             {
@@ -130,6 +138,9 @@ protected:
         oss << (*(current_solution_value->GetSolution()));
         spdlog::info("{} ---> ({})", oss.str(), spdlog::fmt_lib::join(values, ", "));
 */
+        // values obtained through approximate delta cost components are brought back to the exact costs
+        if (current_solution_value->IsApproximate())
+            current_solution_value->Resynchronize();
         assert(current_solution_value->CheckValues());
         
         this->final_solution_value = std::make_shared<SolutionValue>(*current_solution_value);
@@ -0,0 +1,196 @@
+//
+//  hypervolume.hh
+//  easylocal
+//
+//  Online hypervolume indicator of a front of cost vectors (all objectives are minimized).
+//
+
+#pragma once
+
+#include <vector>
+#include <map>
+#include <random>
+#include <limits>
+#include <algorithm>
+#include <numeric>
+#include <cassert>
+#include "concepts.hh"
+#include "dominance.hh"
+
+namespace easylocal {
+
+  /// Volume of the region dominated by a set of points and bounded by a reference point, updated as points are
+  /// added (points dominated by the new ones are implicitly dropped, as they do not change the dominated region).
+  /// The value is exact for two objectives (updated in logarithmic time plus the number of points a new point
+  /// overlaps) and for three objectives (recomputed by a sweep on the third objective, only when the value is
+  /// requested after a change). With more objectives it is estimated from a fixed set of points sampled uniformly in
+  /// the box between a lower bound of the objectives and the reference point: the new points are queued and the
+  /// samples they dominate are marked only when the value is requested, so that adding a point stays cheap.
+  template <Number T>
+  class HypervolumeIndicator
+  {
+  public:
+    HypervolumeIndicator(std::vector<T> reference, std::vector<T> lower = {}, size_t samples = 100000, unsigned long seed = 0) : reference(std::move(reference)), lower(std::move(lower)), samples(samples), seed(seed)
+    {
+      if (this->lower.empty())
+        this->lower.assign(this->reference.size(), T(0));
+      assert(this->lower.size() == this->reference.size());
+      this->Reset();
+    }
+
+    size_t Objectives() const
+    {
+      return reference.size();
+    }
+
+    bool IsExact() const
+    {
+      return Objectives() <= 3;
+    }
+
+    /// Forgets all the points, keeping the reference point (and the samples)
+    void Reset()
+    {
+      volume = 0.0;
+      front.clear();
+      points.clear();
+      dirty = false;
+      if (Objectives() > 3)
+      {
+        if (sample_points.empty())
+          DrawSamples();
+        std::fill(dominated_samples.begin(), dominated_samples.end(), false);
+        dominated_count = 0;
+        pending.clear();
+      }
+    }
+
+    void Add(const std::vector<T>& p)
+    {
+      assert(p.size() == Objectives());
+      // points outside the reference box do not contribute
+      for (size_t k = 0; k < Objectives(); ++k)
+        if (p[k] >= reference[k])
+          return;
+      if (Objectives() == 1)
+        volume = std::max(volume, double(reference[0]) - double(p[0]));
+      else if (Objectives() == 2)
+        volume += AddToFront(front, p[0], p[1], reference[0], reference[1]);
+      else
+      {
+        // with three objectives the points are swept, with more they mark their samples, when the value is requested
+        auto& queue = Objectives() == 3 ? points : pending;
+        if (std::any_of(queue.begin(), queue.end(), [&p](const std::vector<T>& q) { return WeaklyDominates(q.data(), p.data(), q.size()); }))
+          return;
+        std::erase_if(queue, [&p](const std::vector<T>& q) { return WeaklyDominates(p.data(), q.data(), q.size()); });
+        queue.push_back(p);
+        dirty = true;
+      }
+    }
+
+    double Value() const
+    {
+      if (dirty)
+      {
+        volume = Objectives() == 3 ? Sweep() : MarkSamples();
+        dirty = false;
+      }
+      return volume;
+    }
+
+  protected:
+    /// Adds the point (x, y) to a bi-dimensional front (kept sorted by increasing x, hence decreasing y) and returns the
+    /// area it dominates exclusively, i.e., the integral over [x, rx) of the distance between y and the front
+    static double AddToFront(std::map<T, T>& front, T x, T y, T rx, T ry)
+    {
+      // the last point with abscissa not greater than x determines the lowest level already dominated at x
+      auto it = front.upper_bound(x);
+      T level = ry;
+      if (it != front.begin())
+        level = std::prev(it)->second;
+      if (level <= y)
+        return 0.0;
+      double area = 0.0;
+      T from = x;
+      // the points after x whose level is above y are dominated by the new point
+      while (it != front.end() && it->second >= y)
+      {
+        area += (double(it->first) - double(from)) * (double(level) - double(y));
+        from = it->first;
+        level = it->second;
+        it = front.erase(it);
+      }
+      T to = it != front.end() ? it->first : rx;
+      area += (double(to) - double(from)) * (double(level) - double(y));
+      front[x] = y;
+      return area;
+    }
+
+    /// Exact volume in three dimensions, as the sum of the slabs between consecutive values of the third objective
+    double Sweep() const
+    {
+      std::vector<const std::vector<T>*> sorted(points.size());
+      std::transform(points.begin(), points.end(), sorted.begin(), [](const auto& p) { return &p; });
+      std::sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) { return (*a)[2] < (*b)[2]; });
+      std::map<T, T> slice;
+      double area = 0.0, result = 0.0;
+      for (size_t i = 0; i < sorted.size(); ++i)
+      {
+        const auto& p = *sorted[i];
+        area += AddToFront(slice, p[0], p[1], reference[0], reference[1]);
+        T next = i + 1 < sorted.size() ? (*sorted[i + 1])[2] : reference[2];
+        result += area * (double(next) - double(p[2]));
+      }
+      return result;
+    }
+
+    /// Marks the samples dominated by the queued points and returns the estimated volume
+    double MarkSamples() const
+    {
+      for (size_t s = 0; s < samples; ++s)
+        if (!dominated_samples[s] && std::any_of(pending.begin(), pending.end(), [this, s](const std::vector<T>& p) { return WeaklyDominates(p.data(), &sample_points[s * Objectives()], Objectives()); }))
+        {
+          dominated_samples[s] = true;
+          dominated_count++;
+        }
+      pending.clear();
+      return box_volume * double(dominated_count) / double(samples);
+    }
+
+    void DrawSamples()
+    {
+      std::mt19937_64 rng(seed);
+      sample_points.resize(samples * Objectives());
+      box_volume = 1.0;
+      for (size_t k = 0; k < Objectives(); ++k)
+        box_volume *= double(reference[k]) - double(lower[k]);
+      for (size_t s = 0; s < samples; ++s)
+        for (size_t k = 0; k < Objectives(); ++k)
+        {
+          // std::uniform_int_distribution is not defined for the character and short types, hence the wider type
+          if constexpr (std::is_integral_v<T>)
+            sample_points[s * Objectives() + k] = T(std::uniform_int_distribution<std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>>(lower[k], reference[k] - 1)(rng));
+          else
+            sample_points[s * Objectives() + k] = std::uniform_real_distribution<T>(lower[k], reference[k])(rng);
+        }
+      dominated_samples.assign(samples, false);
+    }
+
+    std::vector<T> reference, lower;
+    size_t samples;
+    unsigned long seed;
+    mutable double volume = 0.0;
+    // two objectives: the front, sorted on the first objective
+    std::map<T, T> front;
+    // three objectives: the mutually non-dominated points, swept when the value is requested
+    std::vector<std::vector<T>> points;
+    mutable bool dirty = false;
+    // more objectives: Monte Carlo samples (stored contiguously), whether they are dominated, and the points added since
+    // the samples were last marked
+    std::vector<T> sample_points;
+    mutable std::vector<bool> dominated_samples;
+    mutable size_t dominated_count = 0;
+    mutable std::vector<std::vector<T>> pending;
+    double box_volume = 0.0;
+  };
+}
@@ -11,9 +11,24 @@
 #include "cost-components.hh"
 #include <random>
 #include <variant>
+#include <span>
+#include <optional>
 #include "utils.hh"
 
 namespace easylocal {
+  // The undo token returned by the MakeMove of a neighborhood explorer, std::monostate for those that undo their moves without one
+  template <class NeighborhoodExplorer>
+  struct UndoTokenOf
+  {
+    using type = std::monostate;
+  };
+  
+  template <class NeighborhoodExplorer> requires has_undo_token_move<NeighborhoodExplorer>
+  struct UndoTokenOf<NeighborhoodExplorer>
+  {
+    using type = std::decay_t<decltype(std::declval<const NeighborhoodExplorer&>().MakeMove(std::declval<typename NeighborhoodExplorer::Solution&>(), std::declval<const typename NeighborhoodExplorer::Move&>()))>;
+  };
+  
   // TODO: define the neighborhood concept later and the proper parameters, in particular the same_as for the solution manager
   // TODO: consider whether to pass also Input or not or to simplify the solution class concept having an alternative definition that is Input-less
   // TODO: consider whether the movecoststructure-like related functions should be outsourced in a different class
@@ -43,7 +58,7 @@ class UnionNeighborhoodExplorer : public std::enable_shared_from_this<SelfClass>
 //      delta_cost_components.resize(sm->Components());
     }
         
-    Generator<Move> Neighborhood(std::shared_ptr<const Solution> sol) const
+    Generator<Move> Neighborhood(const Solution& sol) const
     {
       for (size_t i = 0; i < sizeof...(NeighborhoodExplorers); ++i)
       {
@@ -63,7 +78,7 @@ class UnionNeighborhoodExplorer : public std::enable_shared_from_this<SelfClass>
     }
     
     // FIXME: capture empty neighborhood exceptions
-    Move RandomMove(std::shared_ptr<const Solution> sol) const
+    Move RandomMove(const Solution& sol) const
     {
         // FIXME: random seed!
       std::random_device dev;
@@ -74,9 +89,42 @@ class UnionNeighborhoodExplorer : public std::enable_shared_from_this<SelfClass>
       return perform(nhes, pos, cv).move.value();
     }
     
-    void MakeMove(std::shared_ptr<Solution> sol, const Move& mv) const
+    /// Undo token of a move, holding the one returned by the basic neighborhood explorer of the move (std::monostate for
+    /// the explorers that undo their moves without a token)
+    using UndoToken = std::variant<typename UndoTokenOf<NeighborhoodExplorers>::type...>;
+    /// Whether MakeMove returns an undo token, i.e., all the basic neighborhood explorers are able to undo their moves
+    /// and some of them need a token to do it
+    static constexpr bool has_undo_tokens = (has_undo_token_move<NeighborhoodExplorers> || ...) && ((has_undo_move<NeighborhoodExplorers> || has_undo_token_move<NeighborhoodExplorers>) && ...);
+    
+    auto MakeMove(Solution& sol, const Move& mv) const
+    {
+      if constexpr (has_undo_tokens)
+        return this->callMakeMove(sol, mv, std::index_sequence_for<typename NeighborhoodExplorers::Move...>{});
+      else
+        std::visit([&sol, this](auto&& arg) { this->cmv.MakeMove(sol, arg); }, mv);
+    }
+    
+    /// Blocks of the i-th (block-decomposable) cost component touched by the move, as reported by the basic neighborhood explorer of the move
+    bool TouchedBlocks(const Solution& sol, const Move& mv, size_t i, std::vector<size_t>& blocks) const requires (has_touched_blocks<NeighborhoodExplorers> || ...)
+    {
+      return this->callTouchedBlocks(sol, mv, i, blocks, std::index_sequence_for<typename NeighborhoodExplorers::Move...>{});
+    }
+    
+    /// Change of the hash of the solution, as reported by the basic neighborhood explorer of the move
+    std::uint64_t HashDelta(const Solution& sol, const Move& mv) const requires (has_hash_delta<NeighborhoodExplorers> && ...)
+    {
+      return this->callHashDelta(sol, mv, std::index_sequence_for<typename NeighborhoodExplorers::Move...>{});
+    }
+    
+    void UndoMove(Solution& sol, const Move& mv) const requires (has_undo_move<NeighborhoodExplorers> && ...)
     {
-      std::visit([&sol, this](auto&& arg) { this->cmv.MakeMove(sol, arg); }, mv);
+      this->callUndoMove(sol, mv, std::index_sequence_for<typename NeighborhoodExplorers::Move...>{});
+    }
+    
+    /// Rolls back a move through the basic neighborhood explorer of the move, handing it back its own undo token
+    void UndoMove(Solution& sol, const Move& mv, UndoToken token) const requires has_undo_tokens
+    {
+      this->callUndoMove(sol, mv, std::move(token), std::index_sequence_for<typename NeighborhoodExplorers::Move...>{});
     }
             
       // Fallback method to handle the case where the concept is not met
@@ -88,7 +136,7 @@ class UnionNeighborhoodExplorer : public std::enable_shared_from_this<SelfClass>
       
       // Method enabled only if all NeighborhoodExplorerss satisfy has_inverse_move
       // template <typename = std::enable_if_t<(has_inverse_move<NeighborhoodExplorers> && ...)>>
-      bool InverseMove(std::shared_ptr<const Solution> sol, const Move& mv1, const Move& mv2) const requires (has_inverse_move<NeighborhoodExplorers> && ...)
+      bool InverseMove(const Solution& sol, const Move& mv1, const Move& mv2) const requires (has_inverse_move<NeighborhoodExplorers> && ...)
       {
           return false;
 //          return std::visit([&sol, this](auto&& arg1, auto&& arg2) { return this->ci.Inverse(sol, arg1, arg2); }, mv1, mv2);
@@ -108,7 +156,7 @@ class UnionNeighborhoodExplorer : public std::enable_shared_from_this<SelfClass>
       {
         move = Move{t.RandomMove(sol)};
       }
-      std::shared_ptr<const Solution> sol;
+      const Solution& sol;
       std::optional<Move> move;
     };
     
@@ -119,7 +167,7 @@ class UnionNeighborhoodExplorer : public std::enable_shared_from_this<SelfClass>
       {
         generator = GeneratorMove{t.Neighborhood(sol)};
       }
-      std::shared_ptr<const Solution> sol;
+      const Solution& sol;
       GeneratorMove generator;
     };
     
@@ -142,13 +190,37 @@ class UnionNeighborhoodExplorer : public std::enable_shared_from_this<SelfClass>
     
     std::tuple<NeighborhoodExplorers...> nhes;
     CaptureMakeMove cmv;
+    mutable DriftTracker<T> drift_tracker;
 //    CaptureInverse ci;
 //    CaptureHashMove chm;
   public:
     
     MoveValue CreateMoveValue(const SolutionValue& sv, const Move& mv) const
     {
-      return { this->shared_from_this(), sv, mv, sv.size() };
+      return { static_cast<const SelfClass*>(this), sv, mv, sv.size() };
+    }
+    
+    void CreateMoveValues(const SolutionValue& sv, std::span<const Move> moves, std::vector<MoveValue>& move_values) const
+    {
+      move_values.clear();
+      move_values.reserve(moves.size());
+      for (const auto& mv : moves)
+        move_values.push_back(this->CreateMoveValue(sv, mv));
+      // batched deltas are computed on the runs of consecutive moves of the same kind (see MoveBatch)
+      size_t end;
+      for (size_t begin = 0; begin < moves.size(); begin = end)
+      {
+        for (end = begin + 1; end < moves.size() && moves[end].index() == moves[begin].index(); ++end)
+          ;
+        if (!this->callHasBatchDeltaCostComponents(moves[begin], std::index_sequence_for<typename NeighborhoodExplorers::Move...>{}))
+          continue;
+        auto batch = std::make_shared<const MoveBatch<T, Move>>(moves.subspan(begin, end - begin), sv.size());
+        for (size_t k = begin; k < end; ++k)
+        {
+          move_values[k].batch = batch;
+          move_values[k].batch_index = k - begin;
+        }
+      }
     }
     
     template <class BasicMove, DeltaCostComponentT<Input, Solution, T, BasicMove> DCC>
@@ -158,6 +230,32 @@ class UnionNeighborhoodExplorer : public std::enable_shared_from_this<SelfClass>
         static_assert(nhe_index < sizeof...(NeighborhoodExplorers), "Wrong move type, it dows not belong to the set of types handled by the Union Neighborhood Explorer");
       std::get<nhe_index>(nhes).AddDeltaCostComponent(dcc, i);
     }
+    
+    template <class BasicMove, FusedDeltaCostComponentT<Input, Solution, T, BasicMove> FDCC>
+    inline void AddFusedDeltaCostComponent(FDCC& fdcc, size_t i)
+    {
+        constexpr size_t nhe_index = variant_index<size_t(0), BasicMove, typename NeighborhoodExplorers::Move...>();
+        static_assert(nhe_index < sizeof...(NeighborhoodExplorers), "Wrong move type, it dows not belong to the set of types handled by the Union Neighborhood Explorer");
+      std::get<nhe_index>(nhes).AddFusedDeltaCostComponent(fdcc, i);
+    }
+    
+    /// Declares that the moves of kind BasicMove never change the value of the i-th cost component
+    template <class BasicMove>
+    inline void SetUnaffected(size_t i)
+    {
+        constexpr size_t nhe_index = variant_index<size_t(0), BasicMove, typename NeighborhoodExplorers::Move...>();
+        static_assert(nhe_index < sizeof...(NeighborhoodExplorers), "Wrong move type, it dows not belong to the set of types handled by the Union Neighborhood Explorer");
+      std::get<nhe_index>(nhes).SetUnaffected(i);
+    }
+    
+    /// Declares that the moves of kind BasicMove for which affects returns false do not change the value of the i-th cost component
+    template <class BasicMove>
+    inline void SetRelevanceFilter(size_t i, std::function<bool(const Solution&, const BasicMove&)> affects)
+    {
+        constexpr size_t nhe_index = variant_index<size_t(0), BasicMove, typename NeighborhoodExplorers::Move...>();
+        static_assert(nhe_index < sizeof...(NeighborhoodExplorers), "Wrong move type, it dows not belong to the set of types handled by the Union Neighborhood Explorer");
+      std::get<nhe_index>(nhes).SetRelevanceFilter(i, std::move(affects));
+    }
       // FIXME: restate
 //  protected:
 
@@ -179,7 +277,7 @@ class UnionNeighborhoodExplorer : public std::enable_shared_from_this<SelfClass>
     }
       
       template<std::size_t... I>
-      T callDeltaCostComponent(size_t i, std::shared_ptr<const Solution> sol, const Move& move, std::index_sequence<I...>) const
+      T callDeltaCostComponent(size_t i, const Solution& sol, const Move& move, std::index_sequence<I...>) const
       {
           T result = T{0};
           // Using fold expression to call the correct neighborhood explorer's HasDeltaCostComponent
@@ -194,14 +292,368 @@ class UnionNeighborhoodExplorer : public std::enable_shared_from_this<SelfClass>
           return result;
       }
       
+      template<std::size_t... I>
+      bool callTouchedBlocks(const Solution& sol, const Move& move, size_t i, std::vector<size_t>& blocks, std::index_sequence<I...>) const
+      {
+          bool result = false;
+          (..., ([&]() -> bool {
+              if (const auto* ptr = std::get_if<std::variant_alternative_t<I, Move>>(&move))
+              {
+                  if constexpr (has_touched_blocks<std::tuple_element_t<I, std::tuple<NeighborhoodExplorers...>>>)
+                      result = std::get<I>(nhes).TouchedBlocks(sol, *ptr, i, blocks);
+                  return true;
+              }
+              return false;
+          })());
+          return result;
+      }
+      
+      template<std::size_t... I>
+      std::optional<T> callLowerBoundDelta(const Solution& sol, const Move& move, size_t i, std::index_sequence<I...>) const
+      {
+          std::optional<T> result;
+          (..., ([&]() -> bool {
+              if (const auto* ptr = std::get_if<std::variant_alternative_t<I, Move>>(&move))
+              {
+                  result = std::get<I>(nhes).LowerBoundDelta(sol, *ptr, i);
+                  return true;
+              }
+              return false;
+          })());
+          return result;
+      }
+      
+      template<std::size_t... I>
+      EvaluationAutotuner::Selection callSelectEvaluationStrategy(size_t i, const Move& move, std::index_sequence<I...>) const
+      {
+          EvaluationAutotuner::Selection result{ EvaluationStrategy::Delta, false };
+          (..., ([&]() -> bool {
+              if (const auto* ptr = std::get_if<std::variant_alternative_t<I, Move>>(&move))
+              {
+                  result = std::get<I>(nhes).SelectEvaluationStrategy(i, *ptr);
+                  return true;
+              }
+              return false;
+          })());
+          return result;
+      }
+      
+      template<std::size_t... I>
+      void callRecordEvaluationTime(size_t i, const Move& move, EvaluationStrategy strategy, std::chrono::nanoseconds elapsed, std::index_sequence<I...>) const
+      {
+          (..., ([&]() -> bool {
+              if (const auto* ptr = std::get_if<std::variant_alternative_t<I, Move>>(&move))
+              {
+                  std::get<I>(nhes).RecordEvaluationTime(i, *ptr, strategy, elapsed);
+                  return true;
+              }
+              return false;
+          })());
+      }
+      
+      template<std::size_t... I>
+      bool callAffects(const Solution& sol, const Move& move, size_t i, std::index_sequence<I...>) const
+      {
+          bool result = true;
+          (..., ([&]() -> bool {
+              if (const auto* ptr = std::get_if<std::variant_alternative_t<I, Move>>(&move))
+              {
+                  result = std::get<I>(nhes).Affects(sol, *ptr, i);
+                  return true;
+              }
+              return false;
+          })());
+          return result;
+      }
+      
+      template<std::size_t... I>
+      std::uint64_t callHashDelta(const Solution& sol, const Move& move, std::index_sequence<I...>) const
+      {
+          std::uint64_t result = 0;
+          (..., ([&]() -> bool {
+              if (const auto* ptr = std::get_if<std::variant_alternative_t<I, Move>>(&move))
+              {
+                  result = std::get<I>(nhes).HashDelta(sol, *ptr);
+                  return true;
+              }
+              return false;
+          })());
+          return result;
+      }
+      
+      template<std::size_t... I>
+      void callUndoMove(Solution& sol, const Move& move, std::index_sequence<I...>) const
+      {
+          (..., ([&]() -> bool {
+              if (const auto* ptr = std::get_if<std::variant_alternative_t<I, Move>>(&move))
+              {
+                  std::get<I>(nhes).UndoMove(sol, *ptr);
+                  return true;
+              }
+              return false;
+          })());
+      }
+      
+      template<std::size_t... I>
+      UndoToken callMakeMove(Solution& sol, const Move& move, std::index_sequence<I...>) const
+      {
+          std::optional<UndoToken> token;
+          (..., ([&]() -> bool {
+              if (const auto* ptr = std::get_if<std::variant_alternative_t<I, Move>>(&move))
+              {
+                  if constexpr (has_undo_token_move<std::tuple_element_t<I, std::tuple<NeighborhoodExplorers...>>>)
+                      token.emplace(std::in_place_index<I>, std::get<I>(nhes).MakeMove(sol, *ptr));
+                  else
+                  {
+                      std::get<I>(nhes).MakeMove(sol, *ptr);
+                      token.emplace(std::in_place_index<I>);
+                  }
+                  return true;
+              }
+              return false;
+          })());
+          return std::move(*token);
+      }
+      
+      template<std::size_t... I>
+      void callUndoMove(Solution& sol, const Move& move, UndoToken&& token, std::index_sequence<I...>) const
+      {
+          (..., ([&]() -> bool {
+              if (const auto* ptr = std::get_if<std::variant_alternative_t<I, Move>>(&move))
+              {
+                  if constexpr (has_undo_token_move<std::tuple_element_t<I, std::tuple<NeighborhoodExplorers...>>>)
+                      std::get<I>(nhes).UndoMove(sol, *ptr, std::get<I>(std::move(token)));
+                  else
+                      std::get<I>(nhes).UndoMove(sol, *ptr);
+                  return true;
+              }
+              return false;
+          })());
+      }
+      
+      template<std::size_t... I>
+      T callStatefulDeltaCostComponent(size_t i, const SolutionValue& sv, const Move& move, std::index_sequence<I...>) const
+      {
+          T result = T{0};
+          (..., ([&]() -> bool {
+              if (const auto* ptr = std::get_if<std::variant_alternative_t<I, Move>>(&move))
+              {
+                  result = std::get<I>(nhes).ComputeDeltaCost(sv, *ptr, i);
+                  return true;
+              }
+              return false;
+          })());
+          return result;
+      }
+      
+      template<std::size_t... I>
+      bool callUpdateState(size_t i, CostComponentState& st, const Solution& sol, const Move& move, std::index_sequence<I...>) const
+      {
+          bool result = false;
+          (..., ([&]() -> bool {
+              if (const auto* ptr = std::get_if<std::variant_alternative_t<I, Move>>(&move))
+              {
+                  result = std::get<I>(nhes).UpdateState(i, st, sol, *ptr);
+                  return true;
+              }
+              return false;
+          })());
+          return result;
+      }
+      
+      template<std::size_t... I>
+      bool callHasFusedDeltaCostComponent(size_t i, const Move& move, std::index_sequence<I...>) const
+      {
+          bool result = false;
+          (..., ([&]() -> bool {
+              if (const auto* ptr = std::get_if<std::variant_alternative_t<I, Move>>(&move))
+              {
+                  result = std::get<I>(nhes).HasFusedDeltaCostComponent(i, *ptr);
+                  return true;
+              }
+              return false;
+          })());
+          return result;
+      }
+      
+      template<class Cache, std::size_t... I>
+      void callFusedDeltaCostComponent(size_t i, const SolutionValue& sv, const Move& move, Cache& cache, std::index_sequence<I...>) const
+      {
+          (..., ([&]() -> bool {
+              if (const auto* ptr = std::get_if<std::variant_alternative_t<I, Move>>(&move))
+              {
+                  std::get<I>(nhes).ComputeFusedDeltaCosts(sv, *ptr, i, cache);
+                  return true;
+              }
+              return false;
+          })());
+      }
+      
+      template<std::size_t... I>
+      bool callHasBatchDeltaCostComponent(size_t i, const Move& move, std::index_sequence<I...>) const
+      {
+          bool result = false;
+          (..., ([&]() -> bool {
+              if (const auto* ptr = std::get_if<std::variant_alternative_t<I, Move>>(&move))
+              {
+                  result = std::get<I>(nhes).HasBatchDeltaCostComponent(i, *ptr);
+                  return true;
+              }
+              return false;
+          })());
+          return result;
+      }
+      
+      template<std::size_t... I>
+      bool callHasBatchDeltaCostComponents(const Move& move, std::index_sequence<I...>) const
+      {
+          bool result = false;
+          (..., ([&]() -> bool {
+              if (move.index() == I)
+              {
+                  result = std::get<I>(nhes).HasBatchDeltaCostComponents();
+                  return true;
+              }
+              return false;
+          })());
+          return result;
+      }
+      
+      template<std::size_t... I>
+      void callBatchDeltaCostComponent(const SolutionValue& sv, std::span<const Move> moves, size_t i, std::vector<T>& deltas, std::vector<bool>& evaluated, std::index_sequence<I...>) const
+      {
+          // the moves of a batch are all of the same kind, only the neighborhood explorer of that kind is involved
+          (..., ([&]() -> bool {
+              if (moves.front().index() != I)
+                  return false;
+              thread_local std::vector<std::variant_alternative_t<I, Move>> basic_moves;
+              basic_moves.clear();
+              for (const auto& mv : moves)
+                  basic_moves.push_back(std::get<I>(mv));
+              std::get<I>(nhes).ComputeBatchDeltaCosts(sv, basic_moves, i, deltas, evaluated);
+              return true;
+          })());
+      }
+      
   public:
-    T ComputeDeltaCost(std::shared_ptr<const Solution> sol, const Move& mv, size_t i) const
+    /// See NeighborhoodExplorer::ComputeDeltaCost, move values use the overload taking the solution value
+    T ComputeDeltaCost(const Solution& sol, const Move& mv, size_t i) const
     {
         return std::visit([&](auto&&) -> T {
             return this->callDeltaCostComponent(i, sol, mv, std::index_sequence_for<typename NeighborhoodExplorers::Move...>{});
         }, mv);
     }
     
+    T ComputeDeltaCost(const SolutionValue& sv, const Move& mv, size_t i) const
+    {
+        return this->callStatefulDeltaCostComponent(i, sv, mv, std::index_sequence_for<typename NeighborhoodExplorers::Move...>{});
+    }
+    
+    bool UpdateState(size_t i, CostComponentState& st, const Solution& sol, const Move& mv) const
+    {
+        return this->callUpdateState(i, st, sol, mv, std::index_sequence_for<typename NeighborhoodExplorers::Move...>{});
+    }
+    
+    /// Whether the move may change the value of the i-th cost component, as declared to the basic neighborhood explorer of the move
+    bool Affects(const Solution& sol, const Move& mv, size_t i) const
+    {
+        return this->callAffects(sol, mv, i, std::index_sequence_for<typename NeighborhoodExplorers::Move...>{});
+    }
+    
+    /// Autotunes the evaluation strategy of each kind of move separately (see NeighborhoodExplorer::SetAutotuning)
+    void SetAutotuning(size_t samples)
+    {
+        std::apply([samples](auto&... nhe) { (nhe.SetAutotuning(samples), ...); }, nhes);
+    }
+    
+    /// The strategy used to evaluate the i-th component for the moves of kind BasicMove
+    template <class BasicMove>
+    EvaluationStrategy GetEvaluationStrategy(size_t i) const
+    {
+        constexpr size_t nhe_index = variant_index<size_t(0), BasicMove, typename NeighborhoodExplorers::Move...>();
+        static_assert(nhe_index < sizeof...(NeighborhoodExplorers), "Wrong move type, it dows not belong to the set of types handled by the Union Neighborhood Explorer");
+        return std::get<nhe_index>(nhes).GetEvaluationStrategy(i);
+    }
+    
+    template <class BasicMove>
+    EvaluationAutotuner::Timings GetEvaluationTimings(size_t i) const
+    {
+        constexpr size_t nhe_index = variant_index<size_t(0), BasicMove, typename NeighborhoodExplorers::Move...>();
+        static_assert(nhe_index < sizeof...(NeighborhoodExplorers), "Wrong move type, it dows not belong to the set of types handled by the Union Neighborhood Explorer");
+        return std::get<nhe_index>(nhes).GetEvaluationTimings(i);
+    }
+    
+    EvaluationAutotuner::Selection SelectEvaluationStrategy(size_t i, const Move& mv) const
+    {
+        return this->callSelectEvaluationStrategy(i, mv, std::index_sequence_for<typename NeighborhoodExplorers::Move...>{});
+    }
+    
+    void RecordEvaluationTime(size_t i, const Move& mv, EvaluationStrategy strategy, std::chrono::nanoseconds elapsed) const
+    {
+        this->callRecordEvaluationTime(i, mv, strategy, elapsed, std::index_sequence_for<typename NeighborhoodExplorers::Move...>{});
+    }
+    
+    /// Number of committed moves between two resynchronizations of the values computed by approximate delta cost
+    /// components (see DriftTracker), the schedule is shared by all kinds of moves
+    void SetResynchronizationPeriod(size_t period)
+    {
+        drift_tracker.SetPeriod(period);
+    }
+    
+    DriftStatistics GetDriftStatistics(size_t i) const
+    {
+        return drift_tracker.GetStatistics(i);
+    }
+    
+    bool IsApproximate(size_t i) const
+    {
+        return std::apply([i](const auto&... nhe) { return (nhe.IsApproximate(i) || ...); }, nhes);
+    }
+    
+    bool HasApproximateDeltaCostComponents() const
+    {
+        return std::apply([](const auto&... nhe) { return (nhe.HasApproximateDeltaCostComponents() || ...); }, nhes);
+    }
+    
+    bool ScheduleResynchronization() const
+    {
+        return drift_tracker.Commit();
+    }
+    
+    void RecordDrift(size_t i, T approximate, T exact) const
+    {
+        drift_tracker.Record(i, approximate, exact);
+    }
+    
+    /// Cheap lower bound of the delta of the i-th component, as provided by the delta cost components of the basic neighborhood explorer of the move
+    std::optional<T> LowerBoundDelta(const Solution& sol, const Move& mv, size_t i) const
+    {
+        return this->callLowerBoundDelta(sol, mv, i, std::index_sequence_for<typename NeighborhoodExplorers::Move...>{});
+    }
+    
+    bool HasBatchDeltaCostComponent(size_t i, const Move& mv) const
+    {
+        return this->callHasBatchDeltaCostComponent(i, mv, std::index_sequence_for<typename NeighborhoodExplorers::Move...>{});
+    }
+    
+    /// Computes the deltas of the i-th component for a run of moves of the same kind, through the batched delta cost
+    /// component of the basic neighborhood explorer of that kind (see NeighborhoodExplorer::ComputeBatchDeltaCosts)
+    void ComputeBatchDeltaCosts(const SolutionValue& sv, std::span<const Move> moves, size_t i, std::vector<T>& deltas, std::vector<bool>& evaluated) const
+    {
+        this->callBatchDeltaCostComponent(sv, moves, i, deltas, evaluated, std::index_sequence_for<typename NeighborhoodExplorers::Move...>{});
+    }
+    
+    bool HasFusedDeltaCostComponent(size_t i, const Move& mv) const
+    {
+        return this->callHasFusedDeltaCostComponent(i, mv, std::index_sequence_for<typename NeighborhoodExplorers::Move...>{});
+    }
+    
+    template <class Cache>
+    void ComputeFusedDeltaCosts(const SolutionValue& sv, const Move& mv, size_t i, Cache& cache) const
+    {
+        this->callFusedDeltaCostComponent(i, sv, mv, cache, std::index_sequence_for<typename NeighborhoodExplorers::Move...>{});
+    }
+    
     // FIXME: it should go through the variant move to establish if the specific element in the tuple is nullptr or not
     bool HasDeltaCostComponent(size_t i, const Move& mv) const
     {
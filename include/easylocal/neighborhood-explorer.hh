@@ -11,6 +11,8 @@
 #include "cost-components.hh"
 #include "utils.hh"
 #include <exception>
+#include <functional>
+#include <span>
 
 namespace easylocal {
 
@@ -18,7 +20,7 @@ class EmptyNeighborhood : public std::exception
 {};
 
   // TODO: add the proper concepts for solution manager
-  // TODO: the last template parameter is the neighborhood explorer itself, to be used in a CRTP (Curiously Recurring Template Pattern) for providing the make_move method below in a static fashion (therefore without overhead) in C++23 there will be P0847 feature (deducing this) that will allow to get rid of it
+  // TODO: the last template parameter is the neighborhood explorer itself, used in a CRTP (Curiously Recurring Template Pattern) for binding the make_move method in a static fashion (therefore without overhead), in C++23 there will be P0847 feature (deducing this) that will allow to get rid of it
   template <SolutionManagerT _SolutionManager, class _Move, class SelfClass>
 class NeighborhoodExplorer : public std::enable_shared_from_this<SelfClass>
   {
@@ -37,33 +39,315 @@ class NeighborhoodExplorer : public std::enable_shared_from_this<SelfClass>
     NeighborhoodExplorer(std::shared_ptr<const SolutionManager> sm) noexcept
     {
       delta_cost_components.resize(sm->Components());
+      batch_delta_cost_components.resize(sm->Components());
+      fused_delta_cost_components.resize(sm->Components());
+      stateful_delta_cost_components.resize(sm->Components());
+      relevance_filters.resize(sm->Components());
+      lower_bound_delta_cost_components.resize(sm->Components());
+      approximate_delta_cost_components.resize(sm->Components(), false);
+      autotuner.Resize(sm->Components());
     }
     
     MoveValue CreateMoveValue(const SolutionValue& sv, const Move& mv) const
     {
-      auto self = this->shared_from_this();
-      return { self, sv, mv, sv.size() };
+      // the move value refers to the actual explorer, so that MakeMove is statically bound
+      return { static_cast<const SelfClass*>(this), sv, mv, sv.size() };
+    }
+    
+    /// Creates the move values of a chunk of moves, the deltas of the components that provide a batched
+    /// ComputeDeltaCosts are evaluated at once on the whole chunk when the first move value needs them (see MoveBatch)
+    void CreateMoveValues(const SolutionValue& sv, std::span<const Move> moves, std::vector<MoveValue>& move_values) const
+    {
+      move_values.clear();
+      move_values.reserve(moves.size());
+      for (const auto& mv : moves)
+        move_values.push_back(this->CreateMoveValue(sv, mv));
+      if (this->HasBatchDeltaCostComponents())
+      {
+        auto batch = std::make_shared<const MoveBatch<T, Move>>(moves, sv.size());
+        for (size_t k = 0; k < move_values.size(); ++k)
+        {
+          move_values[k].batch = batch;
+          move_values[k].batch_index = k;
+        }
+      }
     }
     
     template <DeltaCostComponentT<Input, Solution, T, Move> DeltaCostComponent>
     void AddDeltaCostComponent(DeltaCostComponent& dcc, size_t i)
     {
-      delta_cost_components[i] = std::make_unique<DeltaCostComponent>(dcc);
+      auto p_dcc = std::make_unique<DeltaCostComponent>(dcc);
+      if constexpr (BatchDeltaCostComponentT<DeltaCostComponent, Input, Solution, T, Move>)
+        batch_delta_cost_components[i] = [c = p_dcc.get()](const Solution& sol, std::span<const Move> mvs, std::span<T> deltas) { c->ComputeDeltaCosts(sol, mvs, deltas); };
+      else
+        batch_delta_cost_components[i] = nullptr;
+      if constexpr (StatefulDeltaCostComponentT<DeltaCostComponent, Input, Solution, T, Move>)
+      {
+        using State = typename DeltaCostComponent::State;
+        stateful_delta_cost_components[i] = {
+          [c = p_dcc.get()](const Solution& sol, const CostComponentState& st, const Move& mv) {
+            return c->ComputeDeltaCost(sol, static_cast<const CostComponentStateOf<State>&>(st).state, mv);
+          },
+          [c = p_dcc.get()](CostComponentState& st, const Solution& sol, const Move& mv) {
+            c->UpdateState(static_cast<CostComponentStateOf<State>&>(st).state, sol, mv);
+          }
+        };
+      }
+      else
+        stateful_delta_cost_components[i] = {};
+      approximate_delta_cost_components[i] = std::derived_from<DeltaCostComponent, ApproximateDeltaCostComponent<Input, Solution, T, Move>>;
+      if constexpr (BoundedDeltaCostComponentT<DeltaCostComponent, Input, Solution, T, Move>)
+        lower_bound_delta_cost_components[i] = [c = p_dcc.get()](const Solution& sol, const Move& mv) { return c->LowerBoundDelta(sol, mv); };
+      else
+        lower_bound_delta_cost_components[i] = nullptr;
+      if constexpr (FilteredDeltaCostComponentT<DeltaCostComponent, Input, Solution, T, Move>)
+        relevance_filters[i] = { false, [c = p_dcc.get()](const Solution& sol, const Move& mv) { return c->Affects(sol, mv); } };
+      delta_cost_components[i] = std::move(p_dcc);
+      fused_delta_cost_components[i] = {};
+    }
+    
+    /// Registers a fused delta cost component for the consecutive cost components starting from the i-th one
+    template <FusedDeltaCostComponentT<Input, Solution, T, Move> FusedDeltaCostComponent>
+    void AddFusedDeltaCostComponent(FusedDeltaCostComponent& fdcc, size_t i)
+    {
+      std::shared_ptr<const FusedDeltaCostComponent> p_fdcc = std::make_shared<FusedDeltaCostComponent>(fdcc);
+      for (size_t j = 0; j < p_fdcc->Components(); ++j)
+      {
+        fused_delta_cost_components[i + j] = { p_fdcc, i };
+        delta_cost_components[i + j] = nullptr;
+        batch_delta_cost_components[i + j] = nullptr;
+        stateful_delta_cost_components[i + j] = {};
+        lower_bound_delta_cost_components[i + j] = nullptr;
+        approximate_delta_cost_components[i + j] = false;
+      }
+    }
+    
+    /// Declares that the moves of this explorer never change the value of the i-th cost component (e.g., moves that only
+    /// touch soft constraints), so that move values take it from the originating solution value without any evaluation
+    void SetUnaffected(size_t i)
+    {
+      relevance_filters[i] = { true, nullptr };
+    }
+    
+    /// Declares that the moves for which affects returns false do not change the value of the i-th cost component
+    void SetRelevanceFilter(size_t i, std::function<bool(const Solution&, const Move&)> affects)
+    {
+      relevance_filters[i] = { false, std::move(affects) };
+    }
+    
+    /// Number of committed moves between two resynchronizations of the values computed by approximate delta cost
+    /// components (see DriftTracker)
+    void SetResynchronizationPeriod(size_t period)
+    {
+      drift_tracker.SetPeriod(period);
+    }
+    
+    /// Drift of the values of the i-th component, measured at the resynchronizations
+    DriftStatistics GetDriftStatistics(size_t i) const
+    {
+      return drift_tracker.GetStatistics(i);
+    }
+    
+    /// Times both the delta and the full evaluation of each component for samples moves, then keeps using the faster
+    /// one (see EvaluationAutotuner); zero disables autotuning
+    void SetAutotuning(size_t samples)
+    {
+      autotuner.SetWarmup(samples);
+    }
+    
+    /// The strategy used to evaluate the i-th component (Delta until the end of the warm-up)
+    EvaluationStrategy GetEvaluationStrategy(size_t i) const
+    {
+      return autotuner.GetStrategy(i);
+    }
+    
+    EvaluationAutotuner::Timings GetEvaluationTimings(size_t i) const
+    {
+      return autotuner.GetTimings(i);
     }
     
 //  protected:
     
+    EvaluationAutotuner::Selection SelectEvaluationStrategy(size_t i, const Move&) const
+    {
+      return autotuner.Select(i);
+    }
+    
+    void RecordEvaluationTime(size_t i, const Move&, EvaluationStrategy strategy, std::chrono::nanoseconds elapsed) const
+    {
+      autotuner.Record(i, strategy, elapsed);
+    }
+    
+    bool IsApproximate(size_t i) const
+    {
+      return approximate_delta_cost_components[i];
+    }
+    
+    bool HasApproximateDeltaCostComponents() const
+    {
+      return std::find(approximate_delta_cost_components.begin(), approximate_delta_cost_components.end(), true) != approximate_delta_cost_components.end();
+    }
+    
+    /// Counts a committed move, returns whether its values have to be resynchronized
+    bool ScheduleResynchronization() const
+    {
+      return drift_tracker.Commit();
+    }
+    
+    void RecordDrift(size_t i, T approximate, T exact) const
+    {
+      drift_tracker.Record(i, approximate, exact);
+    }
+    
+    /// Whether the move may change the value of the i-th cost component
+    bool Affects(const Solution& sol, const Move& mv, size_t i) const
+    {
+      const auto& filter = relevance_filters[i];
+      if (filter.unaffected)
+        return false;
+      return !filter.affects || filter.affects(sol, mv);
+    }
+    
+    /// Cheap lower bound of the delta of the i-th component, if its delta cost component provides one
+    std::optional<T> LowerBoundDelta(const Solution& sol, const Move& mv, size_t i) const
+    {
+      if (!lower_bound_delta_cost_components[i])
+        return std::nullopt;
+      return lower_bound_delta_cost_components[i](sol, mv);
+    }
+    
     bool HasDeltaCostComponent(size_t i, const Move&) const
     {
-      return delta_cost_components[i] != nullptr;
+      return delta_cost_components[i] != nullptr || fused_delta_cost_components[i].component != nullptr;
+    }
+    
+    /// Delta of the i-th component for a bare solution, stateful delta cost components rebuild their state on each call
+    /// (move values go through the overload taking the solution value, which provides it)
+    T ComputeDeltaCost(const Solution& sol, const Move& mv, size_t i) const
+    {
+      if (const auto& [fdcc, first] = fused_delta_cost_components[i]; fdcc)
+      {
+        thread_local std::vector<T> deltas;
+        deltas.assign(fdcc->Components(), T(0));
+        fdcc->ComputeDeltaCosts(sol, mv, deltas);
+        return deltas[i - first];
+      }
+      assert(delta_cost_components[i] != nullptr);
+      return this->delta_cost_components[i]->ComputeDeltaCost(sol, mv);
+    }
+    
+    /// Delta of the i-th component, exploiting the state attached to the solution value when the delta cost component is stateful
+    T ComputeDeltaCost(const SolutionValue& sv, const Move& mv, size_t i) const
+    {
+      if (stateful_delta_cost_components[i].compute)
+      {
+        // the cost component has to be stateful as well, otherwise the state would be rebuilt for each move
+        assert(sv.GetState(i) != nullptr);
+        if (sv.GetState(i))
+          return stateful_delta_cost_components[i].compute(*sv.GetSolution(), *sv.GetState(i), mv);
+      }
+      return this->ComputeDeltaCost(*sv.GetSolution(), mv, i);
     }
     
-    T ComputeDeltaCost(std::shared_ptr<const Solution> sol, const Move& mv, size_t i) const
+    /// Brings the state of the i-th component of sol up to date with the move, returns false if no stateful delta cost
+    /// component is able to do it (hence the state has to be rebuilt)
+    bool UpdateState(size_t i, CostComponentState& st, const Solution& sol, const Move& mv) const
     {
-        assert(delta_cost_components[i] != nullptr);
-        return this->delta_cost_components[i]->ComputeDeltaCost(sol, mv);
+      if (!stateful_delta_cost_components[i].update)
+        return false;
+      stateful_delta_cost_components[i].update(st, sol, mv);
+      return true;
+    }
+    
+    bool HasFusedDeltaCostComponent(size_t i, const Move&) const
+    {
+      return fused_delta_cost_components[i].component != nullptr;
+    }
+    
+    /// Computes all the deltas of the fused delta cost component covering the i-th component in a single pass, and
+    /// stores the resulting values in the cache of a move value
+    template <class Cache>
+    void ComputeFusedDeltaCosts(const SolutionValue& sv, const Move& mv, size_t i, Cache& cache) const
+    {
+      const auto& [fdcc, first] = fused_delta_cost_components[i];
+      assert(fdcc != nullptr);
+      thread_local std::vector<T> deltas;
+      deltas.assign(fdcc->Components(), T(0));
+      fdcc->ComputeDeltaCosts(*sv.GetSolution(), mv, deltas);
+      for (size_t j = 0; j < deltas.size(); ++j)
+        cache.Set(first + j, sv[first + j] + deltas[j]);
+    }
+    
+    bool HasBatchDeltaCostComponent(size_t i, const Move&) const
+    {
+      return batch_delta_cost_components[i] != nullptr;
+    }
+    
+    bool HasBatchDeltaCostComponents() const
+    {
+      return std::any_of(batch_delta_cost_components.begin(), batch_delta_cost_components.end(), [](const auto& c) { return c != nullptr; });
+    }
+    
+    /// Computes the deltas of the i-th component for a chunk of moves through its batched delta cost component, marking
+    /// the evaluated ones. The moves that do not affect the component are skipped, and none is evaluated when the move
+    /// values have to go through their own path, i.e., when the delta cost component reads the state attached to the
+    /// solution value or when the autotuner selects the full evaluation. The batch is timed as a whole during the
+    /// warm-up of the autotuner, each evaluated move counting as a sample.
+    void ComputeBatchDeltaCosts(const SolutionValue& sv, std::span<const Move> moves, size_t i, std::vector<T>& deltas, std::vector<bool>& evaluated) const
+    {
+      assert(batch_delta_cost_components[i] != nullptr);
+      if (stateful_delta_cost_components[i].compute && sv.GetState(i))
+        return;
+      auto [strategy, timed] = autotuner.Select(i);
+      if (strategy == EvaluationStrategy::Full)
+        return;
+      const Solution& sol = *sv.GetSolution();
+      thread_local std::vector<Move> affected;
+      thread_local std::vector<T> affected_deltas;
+      affected.clear();
+      evaluated.assign(moves.size(), false);
+      for (size_t k = 0; k < moves.size(); ++k)
+        if (this->Affects(sol, moves[k], i))
+        {
+          evaluated[k] = true;
+          affected.push_back(moves[k]);
+        }
+      if (affected.empty())
+        return;
+      affected_deltas.resize(affected.size());
+      auto start = timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+      batch_delta_cost_components[i](sol, affected, affected_deltas);
+      if (timed)
+        autotuner.Record(i, EvaluationStrategy::Delta, std::chrono::steady_clock::now() - start, affected.size());
+      deltas.resize(moves.size());
+      for (size_t k = 0, j = 0; k < moves.size(); ++k)
+        if (evaluated[k])
+          deltas[k] = affected_deltas[j++];
     }
 
     std::vector<std::unique_ptr<DeltaCostComponent<Input, Solution, T, Move>>> delta_cost_components;
+    std::vector<std::function<void(const Solution&, std::span<const Move>, std::span<T>)>> batch_delta_cost_components;
+    struct FusedDeltaCostComponentSlot
+    {
+      std::shared_ptr<const FusedDeltaCostComponent<Input, Solution, T, Move>> component;
+      size_t first = 0;
+    };
+    std::vector<FusedDeltaCostComponentSlot> fused_delta_cost_components;
+    struct StatefulDeltaCostComponentSlot
+    {
+      std::function<T(const Solution&, const CostComponentState&, const Move&)> compute;
+      std::function<void(CostComponentState&, const Solution&, const Move&)> update;
+    };
+    std::vector<StatefulDeltaCostComponentSlot> stateful_delta_cost_components;
+    struct RelevanceFilter
+    {
+      bool unaffected = false;
+      std::function<bool(const Solution&, const Move&)> affects;
+    };
+    std::vector<RelevanceFilter> relevance_filters;
+    std::vector<std::function<T(const Solution&, const Move&)>> lower_bound_delta_cost_components;
+    std::vector<bool> approximate_delta_cost_components;
+    mutable DriftTracker<T> drift_tracker;
+    mutable EvaluationAutotuner autotuner;
   };
 }
@@ -0,0 +1,448 @@
+//
+//  pareto-archive.hh
+//  easylocal
+//
+//  Online archive of the non-dominated solution values found by multi-objective runners.
+//
+
+#pragma once
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <cassert>
+#include <concepts>
+#include <optional>
+#include "dominance.hh"
+#include "hypervolume.hh"
+
+namespace easylocal {
+
+  /// Archive of mutually non-dominated solution values (all objectives are minimized).
+  /// Bi-objective archives are kept sorted on the first objective, so that both dominance queries and insertions are
+  /// logarithmic; with more objectives points are organized in an ND-tree (Jaszkiewicz and Lust, 2018), whose nodes
+  /// store the ideal and nadir points of their subtree and are skipped as a whole when they cannot be affected.
+  /// Optionally, an additive epsilon per objective bounds the size of the archive (a value is rejected when some
+  /// archived value is within epsilon of dominating it), and values of equal solutions are stored only once, equality
+  /// being detected through std::hash<Solution> and/or operator== on solutions, when available.
+  /// The hypervolume of the archived values can be tracked as well: since a value enters the archive only if it is not
+  /// dominated and it drops only the values it dominates, the dominated region never shrinks and the indicator is
+  /// just updated with the inserted values.
+  template <class SolutionValue>
+  class ParetoArchive
+  {
+  public:
+    using Solution = typename SolutionValue::Solution;
+    using T = typename SolutionValue::T;
+    using Point = std::vector<T>;
+
+    struct Entry
+    {
+      Point values;
+      SolutionValue solution_value;
+      size_t hash;
+    };
+
+    explicit ParetoArchive(Point epsilon = {}, size_t max_leaf_size = 20, size_t branching = 0) : epsilon(std::move(epsilon)), max_leaf_size(max_leaf_size), branching(branching) {}
+
+    /// Inserts the value unless it is (epsilon-)dominated or it is already archived, then drops the archived values
+    /// it dominates. Returns whether the value has been inserted.
+    bool Insert(const SolutionValue& sv)
+    {
+      Entry e{ sv.GetValues(), sv, HashOf(sv) };
+      if (objectives == 0)
+        Initialize(e.values.size());
+      assert(e.values.size() == objectives);
+      if (IsCovered(e))
+        return false;
+      RemoveDominated(e.values);
+      if (hypervolume)
+        hypervolume->Add(e.values);
+      if (objectives == 2)
+        sorted.emplace(e.values[0], std::move(e));
+      else
+        InsertInto(root, std::move(e));
+      ++count;
+      return true;
+    }
+
+    /// Whether the value would be rejected by the archive
+    bool IsDominated(const SolutionValue& sv) const
+    {
+      if (objectives == 0)
+        return false;
+      Entry e{ sv.GetValues(), sv, HashOf(sv) };
+      return IsCovered(e);
+    }
+
+    size_t size() const
+    {
+      return count;
+    }
+
+    bool empty() const
+    {
+      return count == 0;
+    }
+
+    void clear()
+    {
+      sorted.clear();
+      root.reset();
+      count = 0;
+      objectives = 0;
+      if (hypervolume)
+        hypervolume->Reset();
+    }
+
+    /// Starts tracking the hypervolume of the archived values with respect to the reference point (see
+    /// HypervolumeIndicator for the lower bound and the samples used with more than three objectives)
+    void TrackHypervolume(Point reference, Point lower = {}, size_t samples = 100000)
+    {
+      hypervolume.emplace(std::move(reference), std::move(lower), samples);
+      ForEach([this](const Entry& e) { hypervolume->Add(e.values); });
+    }
+
+    bool TracksHypervolume() const
+    {
+      return hypervolume.has_value();
+    }
+
+    /// Hypervolume of the archived values (zero when it is not tracked)
+    double Hypervolume() const
+    {
+      return hypervolume ? hypervolume->Value() : 0.0;
+    }
+
+    /// Calls f on every archived entry (in ascending order of the first objective for bi-objective archives)
+    template <typename F>
+    void ForEach(F&& f) const
+    {
+      if (objectives == 2)
+      {
+        for (const auto& [key, e] : sorted)
+          f(e);
+      }
+      else if (root)
+        ForEachIn(*root, f);
+    }
+
+    std::vector<SolutionValue> Front() const
+    {
+      std::vector<SolutionValue> front;
+      front.reserve(count);
+      ForEach([&front](const Entry& e) { front.push_back(e.solution_value); });
+      return front;
+    }
+
+    /// Brings the archived values obtained through approximate delta cost components back to the exact costs (see
+    /// SolutionValue::Resynchronize) and archives them again, since the exact values may change their dominance
+    void Resynchronize()
+    {
+      std::vector<SolutionValue> front = Front();
+      if (std::none_of(front.begin(), front.end(), [](const SolutionValue& sv) { return sv.IsApproximate(); }))
+        return;
+      clear();
+      for (auto& sv : front)
+      {
+        if (sv.IsApproximate())
+          sv.Resynchronize();
+        Insert(sv);
+      }
+    }
+
+  protected:
+    struct Node
+    {
+      Point ideal, nadir;
+      std::vector<Entry> entries;
+      std::vector<std::unique_ptr<Node>> children;
+      bool IsLeaf() const
+      {
+        return children.empty();
+      }
+    };
+
+    void Initialize(size_t n)
+    {
+      objectives = n;
+      if (epsilon.empty())
+        epsilon.assign(n, T(0));
+      assert(epsilon.size() == n);
+      bounded = std::any_of(epsilon.begin(), epsilon.end(), [](T eps) { return eps > T(0); });
+      if (branching == 0)
+        branching = n + 1;
+    }
+
+    static size_t HashOf(const SolutionValue& sv)
+    {
+      if constexpr (std::is_default_constructible_v<std::hash<Solution>>)
+        return std::hash<Solution>{}(*sv.GetSolution());
+      else
+        return 0;
+    }
+
+    static bool SameSolution(const Entry& a, const Entry& b)
+    {
+      if constexpr (std::is_default_constructible_v<std::hash<Solution>>)
+      {
+        if (a.hash != b.hash)
+          return false;
+        if constexpr (std::equality_comparable<Solution>)
+          return *a.solution_value.GetSolution() == *b.solution_value.GetSolution();
+        else
+          return true;
+      }
+      else if constexpr (std::equality_comparable<Solution>)
+        return *a.solution_value.GetSolution() == *b.solution_value.GetSolution();
+      else
+        return false;
+    }
+
+    /// a weakly dominates b shifted by the epsilons
+    bool WeaklyDominates(const Point& a, const Point& b) const
+    {
+      if (!bounded)
+        return easylocal::WeaklyDominates(a.data(), b.data(), objectives);
+      for (size_t k = 0; k < objectives; ++k)
+        if (a[k] > b[k] + epsilon[k])
+          return false;
+      return true;
+    }
+
+    static bool Dominates(const Point& a, const Point& b)
+    {
+      return easylocal::Dominates(a.data(), b.data(), a.size());
+    }
+
+    /// Whether the archived entry a rejects the candidate e
+    bool Covers(const Entry& a, const Entry& e) const
+    {
+      if (bounded)
+        return WeaklyDominates(a.values, e.values);
+      if (Dominates(a.values, e.values))
+        return true;
+      return a.values == e.values && SameSolution(a, e);
+    }
+
+    bool IsCovered(const Entry& e) const
+    {
+      if (objectives == 2)
+      {
+        // the last archived point whose first objective does not exceed the candidate's (shifted by epsilon) has the
+        // lowest second objective among those which may cover the candidate
+        auto it = sorted.upper_bound(e.values[0] + epsilon[0]);
+        if (it == sorted.begin())
+          return false;
+        --it;
+        if (Covers(it->second, e))
+          return true;
+        // ties on both objectives are kept contiguous, hence the other equal points precede it
+        while (it != sorted.begin() && it->second.values == e.values)
+        {
+          --it;
+          if (it->second.values == e.values && Covers(it->second, e))
+            return true;
+        }
+        return false;
+      }
+      return root && IsCoveredBy(*root, e);
+    }
+
+    bool IsCoveredBy(const Node& node, const Entry& e) const
+    {
+      // no point of the node can cover the candidate if the ideal point does not
+      if (!WeaklyDominates(node.ideal, e.values))
+        return false;
+      // all points of the node are at least as good as the nadir point
+      if (bounded ? WeaklyDominates(node.nadir, e.values) : Dominates(node.nadir, e.values))
+        return true;
+      if (node.IsLeaf())
+        return std::any_of(node.entries.begin(), node.entries.end(), [this, &e](const Entry& a) { return Covers(a, e); });
+      return std::any_of(node.children.begin(), node.children.end(), [this, &e](const auto& child) { return IsCoveredBy(*child, e); });
+    }
+
+    void RemoveDominated(const Point& p)
+    {
+      if (objectives == 2)
+      {
+        // dominated points have first objective not lower than p's, and second objective non-increasing along the order
+        auto it = sorted.lower_bound(p[0]);
+        while (it != sorted.end() && it->second.values[1] >= p[1])
+        {
+          if (Dominates(p, it->second.values))
+          {
+            it = sorted.erase(it);
+            --count;
+          }
+          else
+            ++it;
+        }
+        return;
+      }
+      if (root && RemoveDominatedFrom(*root, p))
+        root.reset();
+    }
+
+    /// Returns whether the node has become empty
+    bool RemoveDominatedFrom(Node& node, const Point& p)
+    {
+      // p cannot dominate any point of the node if it does not weakly dominate the nadir point
+      if (!easylocal::WeaklyDominates(p.data(), node.nadir.data(), objectives))
+        return false;
+      if (Dominates(p, node.ideal))
+      {
+        count -= Size(node);
+        return true;
+      }
+      if (node.IsLeaf())
+      {
+        auto removed = std::remove_if(node.entries.begin(), node.entries.end(), [&p](const Entry& a) { return Dominates(p, a.values); });
+        count -= std::distance(removed, node.entries.end());
+        node.entries.erase(removed, node.entries.end());
+      }
+      else
+        std::erase_if(node.children, [this, &p](const auto& child) { return RemoveDominatedFrom(*child, p); });
+      if (node.entries.empty() && node.children.empty())
+        return true;
+      UpdateBounds(node);
+      return false;
+    }
+
+    void InsertInto(std::unique_ptr<Node>& node, Entry&& e)
+    {
+      if (!node)
+      {
+        node = std::make_unique<Node>();
+        node->ideal = node->nadir = e.values;
+      }
+      Extend(*node, e.values);
+      if (node->IsLeaf())
+      {
+        node->entries.push_back(std::move(e));
+        if (node->entries.size() > max_leaf_size)
+          Split(*node);
+        return;
+      }
+      // descend into the child whose midpoint is the closest to the new point
+      auto closest = std::min_element(node->children.begin(), node->children.end(), [this, &e](const auto& a, const auto& b) {
+        return MidpointDistance(*a, e.values) < MidpointDistance(*b, e.values);
+      });
+      InsertInto(*closest, std::move(e));
+    }
+
+    /// Splits an overfull leaf into children seeded by mutually distant points
+    void Split(Node& node)
+    {
+      std::vector<Entry> entries = std::move(node.entries);
+      node.entries.clear();
+      std::vector<size_t> seeds;
+      seeds.push_back(0);
+      std::vector<double> distance(entries.size(), std::numeric_limits<double>::infinity());
+      while (seeds.size() < std::min(branching, entries.size()))
+      {
+        for (size_t i = 0; i < entries.size(); ++i)
+          distance[i] = std::min(distance[i], Distance(entries[i].values, entries[seeds.back()].values));
+        size_t farthest = std::max_element(distance.begin(), distance.end()) - distance.begin();
+        // the remaining points coincide with the seeds (e.g., equal values of different solutions)
+        if (distance[farthest] == 0.0)
+          break;
+        seeds.push_back(farthest);
+      }
+      if (seeds.size() < 2)
+      {
+        node.entries = std::move(entries);
+        return;
+      }
+      std::vector<Point> seed_points;
+      for (size_t s : seeds)
+      {
+        seed_points.push_back(entries[s].values);
+        auto child = std::make_unique<Node>();
+        child->ideal = child->nadir = entries[s].values;
+        node.children.push_back(std::move(child));
+      }
+      for (size_t i = 0; i < entries.size(); ++i)
+      {
+        size_t best = 0;
+        for (size_t c = 1; c < seed_points.size(); ++c)
+          if (Distance(entries[i].values, seed_points[c]) < Distance(entries[i].values, seed_points[best]))
+            best = c;
+        Extend(*node.children[best], entries[i].values);
+        node.children[best]->entries.push_back(std::move(entries[i]));
+      }
+    }
+
+    void Extend(Node& node, const Point& p) const
+    {
+      for (size_t k = 0; k < objectives; ++k)
+      {
+        node.ideal[k] = std::min(node.ideal[k], p[k]);
+        node.nadir[k] = std::max(node.nadir[k], p[k]);
+      }
+    }
+
+    void UpdateBounds(Node& node) const
+    {
+      const Point& first = node.IsLeaf() ? node.entries.front().values : node.children.front()->ideal;
+      node.ideal = node.nadir = first;
+      if (node.IsLeaf())
+        for (const auto& e : node.entries)
+          Extend(node, e.values);
+      else
+        for (const auto& child : node.children)
+        {
+          Extend(node, child->ideal);
+          Extend(node, child->nadir);
+        }
+    }
+
+    static double Distance(const Point& a, const Point& b)
+    {
+      double d = 0.0;
+      for (size_t k = 0; k < a.size(); ++k)
+        d += (double(a[k]) - double(b[k])) * (double(a[k]) - double(b[k]));
+      return d;
+    }
+
+    double MidpointDistance(const Node& node, const Point& p) const
+    {
+      double d = 0.0;
+      for (size_t k = 0; k < objectives; ++k)
+      {
+        double m = (double(node.ideal[k]) + double(node.nadir[k])) / 2.0 - double(p[k]);
+        d += m * m;
+      }
+      return d;
+    }
+
+    static size_t Size(const Node& node)
+    {
+      size_t s = node.entries.size();
+      for (const auto& child : node.children)
+        s += Size(*child);
+      return s;
+    }
+
+    template <typename F>
+    static void ForEachIn(const Node& node, F& f)
+    {
+      for (const auto& e : node.entries)
+        f(e);
+      for (const auto& child : node.children)
+        ForEachIn(*child, f);
+    }
+
+    Point epsilon;
+    size_t max_leaf_size, branching;
+    size_t objectives = 0, count = 0;
+    bool bounded = false;
+    std::multimap<T, Entry> sorted;
+    std::unique_ptr<Node> root;
+    std::optional<HypervolumeIndicator<T>> hypervolume;
+  };
+}
@@ -0,0 +1,316 @@
+//
+//  persistent-vector.hh
+//  easylocal
+//
+//  Vector with copy-on-write chunks, to build solutions whose copies share most of their memory.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <iterator>
+#include <initializer_list>
+#include <algorithm>
+#include <utility>
+#include <cassert>
+#include <compare>
+
+namespace easylocal {
+
+  /// Sequence of elements stored in fixed-size chunks, which are shared among the copies of the vector and copied only
+  /// when one of the copies modifies them. Copying the vector costs a single reference count update, and modifying an
+  /// element of a copy costs (the first time) a copy of the chunk table and of the chunk containing the element.
+  /// Solutions built on persistent vectors are therefore materialized by MoveValue::GetSolution in time proportional
+  /// to the chunks changed by the move (plus the chunk table) rather than to the size of the solution, and the
+  /// solutions kept by the runners (e.g., histories and best-solution snapshots) share the chunks they have in common.
+  /// Elements are read through the const interface only, writes go through Set or Mutable (which copy the chunk if it
+  /// is shared), hence reading from a non-const vector never copies anything.
+  template <class T, size_t ChunkSize = 64>
+  class PersistentVector
+  {
+    static_assert(ChunkSize > 0, "Chunks must hold at least one element");
+    using Chunk = std::vector<T>;
+    using Directory = std::vector<std::shared_ptr<Chunk>>;
+
+  public:
+    using value_type = T;
+    using size_type = size_t;
+    using const_reference = const T&;
+
+    /// Random-access iterator on the elements (the other comparison operators are synthesized from == and <=>)
+    class const_iterator
+    {
+    public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const T*;
+      using reference = const T&;
+
+      const_iterator() = default;
+      const_iterator(const PersistentVector* v, size_t i) : v(v), i(i) {}
+
+      reference operator*() const
+      {
+        return (*v)[i];
+      }
+
+      pointer operator->() const
+      {
+        return &(*v)[i];
+      }
+
+      reference operator[](difference_type n) const
+      {
+        return (*v)[i + n];
+      }
+
+      const_iterator& operator++()
+      {
+        ++i;
+        return *this;
+      }
+
+      const_iterator operator++(int)
+      {
+        const_iterator tmp = *this;
+        ++i;
+        return tmp;
+      }
+
+      const_iterator& operator--()
+      {
+        --i;
+        return *this;
+      }
+
+      const_iterator operator--(int)
+      {
+        const_iterator tmp = *this;
+        --i;
+        return tmp;
+      }
+
+      const_iterator& operator+=(difference_type n)
+      {
+        i += n;
+        return *this;
+      }
+
+      const_iterator& operator-=(difference_type n)
+      {
+        i -= n;
+        return *this;
+      }
+
+      friend const_iterator operator+(const_iterator it, difference_type n)
+      {
+        return it += n;
+      }
+
+      friend const_iterator operator+(difference_type n, const_iterator it)
+      {
+        return it += n;
+      }
+
+      friend const_iterator operator-(const_iterator it, difference_type n)
+      {
+        return it -= n;
+      }
+
+      friend difference_type operator-(const const_iterator& a, const const_iterator& b)
+      {
+        return difference_type(a.i) - difference_type(b.i);
+      }
+
+      bool operator==(const const_iterator& other) const
+      {
+        return i == other.i;
+      }
+
+      auto operator<=>(const const_iterator& other) const
+      {
+        return i <=> other.i;
+      }
+
+    protected:
+      const PersistentVector* v = nullptr;
+      size_t i = 0;
+    };
+
+    PersistentVector() = default;
+    PersistentVector(const PersistentVector&) = default;
+    PersistentVector& operator=(const PersistentVector&) = default;
+
+    PersistentVector(PersistentVector&& other) noexcept : directory(std::move(other.directory)), count(std::exchange(other.count, 0)) {}
+
+    PersistentVector& operator=(PersistentVector&& other) noexcept
+    {
+      directory = std::move(other.directory);
+      count = std::exchange(other.count, 0);
+      return *this;
+    }
+
+    explicit PersistentVector(size_t n, const T& value = T())
+    {
+      this->resize(n, value);
+    }
+
+    PersistentVector(std::initializer_list<T> values) : PersistentVector(values.begin(), values.end()) {}
+
+    template <std::input_iterator It>
+    PersistentVector(It first, It last)
+    {
+      for (; first != last; ++first)
+        this->push_back(*first);
+    }
+
+    size_t size() const
+    {
+      return count;
+    }
+
+    bool empty() const
+    {
+      return count == 0;
+    }
+
+    const T& operator[](size_t i) const
+    {
+      assert(i < count);
+      return (*(*directory)[i / ChunkSize])[i % ChunkSize];
+    }
+
+    const T& front() const
+    {
+      return (*this)[0];
+    }
+
+    const T& back() const
+    {
+      return (*this)[count - 1];
+    }
+
+    const_iterator begin() const
+    {
+      return { this, 0 };
+    }
+
+    const_iterator end() const
+    {
+      return { this, count };
+    }
+
+    void Set(size_t i, T value)
+    {
+      this->Mutable(i) = std::move(value);
+    }
+
+    /// Writable access to the i-th element, its chunk is copied first if it is shared with other vectors
+    T& Mutable(size_t i)
+    {
+      assert(i < count);
+      return this->MutableChunk(i / ChunkSize)[i % ChunkSize];
+    }
+
+    void push_back(T value)
+    {
+      if (count % ChunkSize == 0)
+      {
+        auto chunk = std::make_shared<Chunk>();
+        chunk->reserve(ChunkSize);
+        this->MutableDirectory().push_back(std::move(chunk));
+      }
+      this->MutableChunk(count / ChunkSize).push_back(std::move(value));
+      ++count;
+    }
+
+    void pop_back()
+    {
+      assert(count > 0);
+      --count;
+      if (count % ChunkSize == 0)
+        this->MutableDirectory().pop_back();
+      else
+        this->MutableChunk(count / ChunkSize).pop_back();
+    }
+
+    void resize(size_t n, const T& value = T())
+    {
+      while (count > n)
+        this->pop_back();
+      while (count < n)
+        this->push_back(value);
+    }
+
+    void clear()
+    {
+      directory.reset();
+      count = 0;
+    }
+
+    /// Number of chunks stored at the same position of both vectors and shared by them
+    size_t SharedChunks(const PersistentVector& other) const
+    {
+      if (!directory || !other.directory)
+        return 0;
+      size_t n = std::min(directory->size(), other.directory->size()), shared = 0;
+      for (size_t c = 0; c < n; ++c)
+        shared += (*directory)[c] == (*other.directory)[c];
+      return shared;
+    }
+
+    /// Equality of the elements, shared chunks are not compared
+    bool operator==(const PersistentVector& other) const
+    {
+      if (count != other.count)
+        return false;
+      if (count == 0 || directory == other.directory)
+        return true;
+      for (size_t c = 0; c < directory->size(); ++c)
+        if ((*directory)[c] != (*other.directory)[c] && *(*directory)[c] != *(*other.directory)[c])
+          return false;
+      return true;
+    }
+
+  protected:
+    /// Whether the object is referred only by p, the fence orders the writes that follow after the releases of the
+    /// other owners (use_count is a relaxed load)
+    template <class U>
+    static bool IsUnique(const std::shared_ptr<U>& p)
+    {
+      if (p.use_count() != 1)
+        return false;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return true;
+    }
+
+    Directory& MutableDirectory()
+    {
+      if (!directory)
+        directory = std::make_shared<Directory>();
+      else if (!IsUnique(directory))
+        directory = std::make_shared<Directory>(*directory);
+      return *directory;
+    }
+
+    Chunk& MutableChunk(size_t c)
+    {
+      auto& chunk = this->MutableDirectory()[c];
+      if (!IsUnique(chunk))
+      {
+        auto copy = std::make_shared<Chunk>();
+        copy->reserve(ChunkSize);
+        copy->assign(chunk->begin(), chunk->end());
+        chunk = std::move(copy);
+      }
+      return *chunk;
+    }
+
+    std::shared_ptr<Directory> directory;
+    size_t count = 0;
+  };
+}
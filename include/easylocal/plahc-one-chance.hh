@@ -8,6 +8,7 @@
 #pragma once
 
 #include "solution-manager.hh"
+#include "pareto-archive.hh"
 #include <iostream>
 #include <thread>
 #include <future>
@@ -40,13 +41,22 @@ namespace easylocal {
       thr.join();
     }
 
+    const ParetoArchive<SolutionValue<Input, Solution, T, CostStructure>>& GetArchive() const
+    {
+      return archive;
+    }
+
     void Run(std::shared_ptr<const Input> in)
     {
       stop_run = false;
       std::vector<SolutionValue<Input, Solution, T, CostStructure>> history;
       history.reserve(history_length);
+      archive.clear();
       for (size_t i = 0; i < history_length; ++i)
+      {
         history.push_back(sm->CreateSolutionValue(sm->InitialSolution(in)));
+        archive.Insert(history.back());
+      }
       iteration = 0;
       idle_iteration = 0;
       size_t index = 0;
@@ -54,10 +64,13 @@ namespace easylocal {
       while ((iteration < max_iterations || idle_iteration <= 0.02 * iteration) && !stop_run)
       {
         size_t next_index = (index + 1) % history.size();
-        auto current_move_value = ne->CreateMoveValue(current_solution_value, ne->RandomMove(current_solution_value.GetSolution()));
+        auto current_move_value = ne->CreateMoveValue(current_solution_value, ne->RandomMove(*current_solution_value.GetSolution()));
         if (current_move_value < current_solution_value)
         {
           history[index] = current_move_value;
+          archive.Insert(history[index]);
+          // the move value refers to the current solution value, which is going to be replaced
+          current_move_value.Detach();
           current_solution_value = history[next_index];
           index = (index + 1) % history.size();
           idle_iteration = 0;
@@ -76,32 +89,17 @@ namespace easylocal {
         }
         iteration++;
       }
-      // post process solutions to get the pareto set
-      std::vector<SolutionValue<Input, Solution, T, CostStructure>> pareto_front;
-      for (size_t i = 0; i < history.size(); ++i)
-      {
-        bool non_dominated = true, drop_equal_solutions = false;
-        for (size_t j = 0; j < history.size(); ++j)
+      // values obtained through approximate delta cost components are brought back to the exact costs, which may change
+      // their dominance, before being reported
+      archive.Resynchronize();
+      for (auto& sv : history)
+        if (sv.IsApproximate())
         {
-          if (i == j)
-            continue;
-          if (history[i] > history[j])
-          {
-            non_dominated = false;
-            break;
-          }
-          if constexpr(std::equality_comparable<Solution>)
-          {
-            if (*history[i].GetSolution() == *history[j].GetSolution() && i > j)
-            {
-              drop_equal_solutions = true;
-              break;
-            }
-          }
+          sv.Resynchronize();
+          archive.Insert(sv);
         }
-        if (non_dominated && !drop_equal_solutions)
-          pareto_front.emplace_back(history[i]);
-      }
+      // the archive has kept the non-dominated solutions found along the search
+      auto pareto_front = archive.Front();
       std::cout << "Pareto front size: " << pareto_front.size() << std::endl;
       for (const auto& sol : pareto_front)
       {
@@ -109,6 +107,7 @@ namespace easylocal {
         auto values = sol.GetValues();
         std::copy(values.begin(), values.end(), std::ostream_iterator<T>(std::cout, " "));
         std::cout << std::endl;
+        assert(sol.CheckValues());
       }
       std::cout << "Iterations: " << iteration << std::endl;
     }
@@ -118,6 +117,7 @@ namespace easylocal {
     size_t iteration = 0, idle_iteration = 0, max_iterations = 1000000;
     // parameter
     size_t history_length;
+    ParetoArchive<SolutionValue<Input, Solution, T, CostStructure>> archive;
     std::atomic_bool stop_run;
   };
 }
@@ -8,10 +8,14 @@
 #pragma once
 
 #include "solution-manager.hh"
+#include "pareto-archive.hh"
 #include "runner.hh"
 #include <iostream>
 #include <iterator>
 #include <memory>
+#include <mutex>
+#include <functional>
+#include <chrono>
 #include <spdlog/spdlog.h>
 
 namespace easylocal {
@@ -25,17 +29,84 @@ namespace easylocal {
     using CostStructure = typename Runner<SolutionManager, NeighborhoodExplorer>::CostStructure ;
     using Move = typename Runner<SolutionManager, NeighborhoodExplorer>::Move;
     
+    /// Snapshot of the progress of a run, taken every sampling_interval iterations and at the end of the run (when
+    /// sampling is enabled)
+    struct Statistics
+    {
+      size_t iteration = 0, idle_iteration = 0, front_size = 0;
+      double hypervolume = 0.0;
+      std::chrono::milliseconds elapsed{ 0 };
+    };
+    
     PLAHC(std::shared_ptr<const SolutionManager> sm, std::shared_ptr<const NeighborhoodExplorer> ne, size_t history_length) : Runner<SolutionManager, NeighborhoodExplorer>(sm, ne), history_length(history_length) {}  
+
+    const ParetoArchive<SolutionValue<Input, Solution, T, CostStructure>>& GetArchive() const
+    {
+      return archive;
+    }
+
+    /// Tracks the hypervolume of the archive with respect to the reference point (the lower bound of the objectives
+    /// and the number of samples are used only to estimate it with more than three objectives)
+    void SetHypervolumeReference(std::vector<T> reference, std::vector<T> lower = {}, size_t samples = 100000)
+    {
+      archive.TrackHypervolume(std::move(reference), std::move(lower), samples);
+    }
+
+    /// Takes a snapshot every interval iterations (zero disables sampling); the observer, if any, is called on each
+    /// snapshot from the running thread and stops the run by returning true (e.g., when the hypervolume stagnates)
+    void SetSampling(size_t interval, std::function<bool(const Statistics&)> observer = nullptr)
+    {
+      sampling_interval = interval;
+      this->observer = std::move(observer);
+    }
+
+    /// The latest snapshot of the current (or last) run, safe to call while the run is in progress
+    Statistics GetStatistics() const
+    {
+      std::lock_guard<std::mutex> lock(statistics_mutex);
+      return trace.empty() ? Statistics() : trace.back();
+    }
+
+    /// All the snapshots of the current (or last) run
+    std::vector<Statistics> GetTrace() const
+    {
+      std::lock_guard<std::mutex> lock(statistics_mutex);
+      return trace;
+    }
   protected:
+    /// Records a snapshot and returns whether the observer asks to stop the run
+    bool Sample(size_t iteration, size_t idle_iteration, std::chrono::steady_clock::time_point start)
+    {
+      Statistics st;
+      st.iteration = iteration;
+      st.idle_iteration = idle_iteration;
+      st.front_size = archive.size();
+      st.hypervolume = archive.Hypervolume();
+      st.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+      {
+        std::lock_guard<std::mutex> lock(statistics_mutex);
+        trace.push_back(st);
+      }
+      return observer && observer(st);
+    }
 
     virtual void Go(std::shared_ptr<const Input> in) override
     {
       size_t iteration = 0, idle_iteration = 0;
+      auto start = std::chrono::steady_clock::now();
       this->ResetStopRun();
+      {
+        std::lock_guard<std::mutex> lock(statistics_mutex);
+        trace.clear();
+      }
       std::vector<SolutionValue<Input, Solution, T, CostStructure>> history;
       history.reserve(history_length);
+      archive.clear();
       for (size_t i = 0; i < history_length; ++i)
+      {
         history.push_back(this->sm->CreateSolutionValue(this->sm->InitialSolution(in)));
+        archive.Insert(history.back());
+      }
       iteration = 0;
       idle_iteration = 0;
       size_t index = 0;
@@ -43,18 +114,25 @@ namespace easylocal {
       while ((iteration < max_iterations || idle_iteration <= 0.02 * iteration) && !this->StopRun())
       {
         size_t next_index = (index + 1) % history.size();
-        auto current_move_value = this->ne->CreateMoveValue(current_solution_value, this->ne->RandomMove(current_solution_value.GetSolution()));
+        auto current_move_value = this->ne->CreateMoveValue(current_solution_value, this->ne->RandomMove(*current_solution_value.GetSolution()));
         if (current_move_value < current_solution_value)
         {
           history[index] = current_move_value;
+          archive.Insert(history[index]);
+          // the move value refers to the current solution value, which is going to be replaced
+          current_move_value.Detach();
           current_solution_value = history[next_index];
           index = (index + 1) % history.size();
           idle_iteration = 0;
         }
         else if (current_move_value < history[next_index])
         {
-          current_solution_value = history[next_index];
+          // the move value refers to the current solution value, hence it has to be committed before the latter is replaced
+          auto next_solution_value = history[next_index];
           history[next_index] = current_move_value;
+          current_move_value.Detach();
+          current_solution_value = std::move(next_solution_value);
+          archive.Insert(history[next_index]);
           index = (index + 2) % history.size();
           idle_iteration = 0;
         } else {
@@ -63,34 +141,25 @@ namespace easylocal {
           idle_iteration++;
         }
         iteration++;
+        if (sampling_interval > 0 && iteration % sampling_interval == 0 && Sample(iteration, idle_iteration, start))
+          break;
       }
-      // post process solutions to get the pareto set
-      std::vector<SolutionValue<Input, Solution, T, CostStructure>> pareto_front;
-      for (size_t i = 0; i < history.size(); ++i)
-      {
-        bool non_dominated = true, drop_equal_solutions = false;
-        for (size_t j = 0; j < history.size(); ++j)
+      // values obtained through approximate delta cost components are brought back to the exact costs, which may change
+      // their dominance, before being sampled and reported
+      archive.Resynchronize();
+      for (auto& sv : history)
+        if (sv.IsApproximate())
         {
-          if (i == j)
-            continue;
-          if (history[i] > history[j])
-          {
-            non_dominated = false;
-            break;
-          }
-          if constexpr(std::equality_comparable<Solution>)
-          {
-            if (*history[i].GetSolution() == *history[j].GetSolution() && i > j)
-            {
-              drop_equal_solutions = true;
-              break;
-            }
-          }
+          sv.Resynchronize();
+          archive.Insert(sv);
         }
-        if (non_dominated && !drop_equal_solutions)
-          pareto_front.emplace_back(history[i]);
-      }
+      if (sampling_interval > 0 && iteration % sampling_interval != 0)
+        Sample(iteration, idle_iteration, start);
+      // the archive has kept the non-dominated solutions found along the search
+      auto pareto_front = archive.Front();
       spdlog::info("Pareto front size: {}", pareto_front.size());
+      if (archive.TracksHypervolume())
+        spdlog::info("Hypervolume: {}", archive.Hypervolume());
       for (const auto& sol : pareto_front)
       {
         auto values = sol.GetValues();
@@ -108,5 +177,11 @@ namespace easylocal {
     // parameters
     size_t max_iterations = 1000000;
     size_t history_length;
+    size_t sampling_interval = 0;
+    std::function<bool(const Statistics&)> observer;
+    // statistics
+    std::vector<Statistics> trace;
+    mutable std::mutex statistics_mutex;
+    ParetoArchive<SolutionValue<Input, Solution, T, CostStructure>> archive;
   };
 }
@@ -76,7 +76,7 @@ protected:
                     {
                         continue;
                     }
-                    if (!best_move_value_initialized || *current_move_value < *best_move_value)
+                    if (!best_move_value_initialized || current_move_value->BoundedLess(*best_move_value))
                     {
                         best_move_value = std::make_shared<MoveValue>(*current_move_value);
                         best_move_value_initialized = true;
@@ -112,11 +112,22 @@ protected:
                 }
             }
             
+            // the move values refer to the current solution value, which is going to be replaced
+            best_move_value->Detach();
+            if (current_move_value)
+                current_move_value->Detach();
             current_solution_value = std::make_shared<SolutionValue>(*best_move_value);
             std::ostringstream oss;
             oss << (*(current_solution_value->GetSolution()));
             // std::cout << oss.str() << std::endl;
-            spdlog::info("{} --> {}", oss.str(), current_solution_value->AggregatedCost());
+            if constexpr (requires { current_solution_value->AggregatedCost(); })
+                spdlog::info("{} --> {}", oss.str(), current_solution_value->AggregatedCost());
+            else
+            {
+                std::ostringstream oss_value;
+                oss_value << *current_solution_value;
+                spdlog::info("{} --> {}", oss.str(), oss_value.str());
+            }
             if (*current_solution_value < *best_solution_value)
             {
                 best_solution_value = std::make_shared<SolutionValue>(*current_solution_value);
@@ -144,6 +155,11 @@ protected:
         // oss << (*(best_solution_value->GetSolution()));
         // spdlog::info("{} ---> ({})", oss.str(), spdlog::fmt_lib::join(values, ", "));
         // spdlog::info("Idle iterations: {} // Total iterations: {}", idle_iteration, iteration);
+        // values obtained through approximate delta cost components are brought back to the exact costs
+        if (current_solution_value->IsApproximate())
+            current_solution_value->Resynchronize();
+        if (best_solution_value->IsApproximate())
+            best_solution_value->Resynchronize();
 #if !defined(NDEBUG)
         spdlog::debug("Very end: iteration: {} // idle_iteration:{}", iteration, idle_iteration);
         spdlog::debug("Checking current solution");
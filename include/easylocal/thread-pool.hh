@@ -0,0 +1,142 @@
+//
+//  thread-pool.hh
+//  easylocal
+//
+//  Pool of worker threads used for the parallel evaluation of the cost components.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+
+namespace easylocal {
+
+  /// Fixed-size pool of worker threads. It is meant to be shared (e.g., among the cost structures of a portfolio of
+  /// runners), hence ParallelFor can be called concurrently and even from within a task running on the pool: the
+  /// calling thread takes part in the loop, so that it never waits for work that no thread would pick up.
+  class ThreadPool
+  {
+  public:
+    explicit ThreadPool(size_t threads = std::max(1u, std::thread::hardware_concurrency()))
+    {
+      workers.reserve(threads);
+      for (size_t t = 0; t < threads; ++t)
+        workers.emplace_back([this]() { this->Work(); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+      }
+      task_available.notify_all();
+      for (auto& worker : workers)
+        worker.join();
+    }
+
+    size_t Size() const
+    {
+      return workers.size();
+    }
+
+    /// Runs f(k) for each k in [0, n), on the pool threads and on the calling thread, and returns once all the calls
+    /// have completed; the first exception thrown by f (if any) is rethrown in the calling thread
+    template <typename F>
+    void ParallelFor(size_t n, F&& f)
+    {
+      if (n == 0)
+        return;
+      if (n == 1 || workers.empty())
+      {
+        for (size_t k = 0; k < n; ++k)
+          f(k);
+        return;
+      }
+      // the loop state is shared with the helper tasks, which may start after the loop has completed
+      struct Loop
+      {
+        std::atomic<size_t> next{ 0 };
+        size_t n, done = 0;
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::exception_ptr error;
+      };
+      auto loop = std::make_shared<Loop>();
+      loop->n = n;
+      auto run = [loop, &f]() {
+        size_t completed = 0;
+        for (size_t k = loop->next.fetch_add(1, std::memory_order_relaxed); k < loop->n; k = loop->next.fetch_add(1, std::memory_order_relaxed))
+        {
+          try
+          {
+            f(k);
+          }
+          catch (...)
+          {
+            std::lock_guard<std::mutex> lock(loop->mutex);
+            if (!loop->error)
+              loop->error = std::current_exception();
+          }
+          completed++;
+        }
+        if (completed > 0)
+        {
+          std::lock_guard<std::mutex> lock(loop->mutex);
+          loop->done += completed;
+          if (loop->done == loop->n)
+            loop->finished.notify_all();
+        }
+      };
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t t = 0; t < std::min(n - 1, workers.size()); ++t)
+          tasks.emplace_back(run);
+      }
+      task_available.notify_all();
+      run();
+      // f is referenced by the helper tasks only while they hold an index, i.e., until the loop is done
+      std::unique_lock<std::mutex> lock(loop->mutex);
+      loop->finished.wait(lock, [&loop]() { return loop->done == loop->n; });
+      if (loop->error)
+        std::rethrow_exception(loop->error);
+    }
+
+  protected:
+    void Work()
+    {
+      while (true)
+      {
+        std::function<void()> task;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          task_available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+          if (tasks.empty())
+            return;
+          task = std::move(tasks.front());
+          tasks.pop_front();
+        }
+        task();
+      }
+    }
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable task_available;
+    bool stopping = false;
+  };
+}
@@ -0,0 +1,141 @@
+//
+//  transposition-table.hh
+//  easylocal
+//
+//  Bounded table of the cost component values of already evaluated solutions, indexed by solution hash.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <span>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <cassert>
+
+namespace easylocal {
+
+  /// Maps the (Zobrist) hash of a solution to the values of its cost components, so that solutions visited again are
+  /// not evaluated again. The table has a fixed number of two-entry buckets (the capacity is rounded up to a power of
+  /// two): the most recently stored or found entry of a bucket is kept first, and the other one is evicted when a new
+  /// hash falls into a full bucket. Keys and values are stored in flat arrays, so that a lookup touches the two
+  /// adjacent keys of a bucket and the values of the entry found only. Solutions are identified by their hash alone,
+  /// hence hashes are expected to be wide enough (e.g., 64-bit Zobrist keys) to make collisions negligible.
+  /// Concurrent tables (e.g., shared by the runners of a portfolio) lock the bucket being accessed, on a fixed set of
+  /// mutexes.
+  template <class T>
+  class TranspositionTable
+  {
+  public:
+    TranspositionTable(size_t components, size_t capacity = size_t(1) << 16, bool concurrent = false) : components(components)
+    {
+      buckets = 1;
+      while (2 * buckets < capacity)
+        buckets <<= 1;
+      keys.assign(2 * buckets, 0);
+      used.assign(2 * buckets, 0);
+      values.assign(2 * buckets * components, T(0));
+      if (concurrent)
+        stripes = std::make_unique<std::mutex[]>(stripe_count);
+    }
+
+    size_t Components() const
+    {
+      return components;
+    }
+
+    size_t Capacity() const
+    {
+      return 2 * buckets;
+    }
+
+    /// Copies the values stored for the hash into values, returns whether they were found
+    bool Load(std::uint64_t hash, std::span<T> values)
+    {
+      assert(values.size() == components);
+      size_t b = hash & (buckets - 1);
+      auto lock = this->Lock(b);
+      lookups.fetch_add(1, std::memory_order_relaxed);
+      for (size_t e = 2 * b; e < 2 * b + 2; ++e)
+        if (used[e] && keys[e] == hash)
+        {
+          std::copy_n(this->values.begin() + e * components, components, values.begin());
+          if (e != 2 * b)
+            this->Swap(e, 2 * b);
+          hits.fetch_add(1, std::memory_order_relaxed);
+          return true;
+        }
+      return false;
+    }
+
+    /// Stores the values for the hash, possibly evicting the least recent entry of its bucket
+    void Store(std::uint64_t hash, std::span<const T> values)
+    {
+      assert(values.size() == components);
+      size_t b = hash & (buckets - 1);
+      auto lock = this->Lock(b);
+      size_t e = 2 * b;
+      if (used[e + 1] && keys[e + 1] == hash)
+        this->Swap(e, e + 1);
+      else if (!(used[e] && keys[e] == hash))
+      {
+        // the first entry becomes the second one (evicting the latter), then it is overwritten
+        keys[e + 1] = keys[e];
+        used[e + 1] = used[e];
+        std::copy_n(this->values.begin() + e * components, components, this->values.begin() + (e + 1) * components);
+        keys[e] = hash;
+        used[e] = 1;
+      }
+      std::copy_n(values.begin(), components, this->values.begin() + e * components);
+    }
+
+    void Clear()
+    {
+      for (size_t b = 0; b < buckets; ++b)
+      {
+        auto lock = this->Lock(b);
+        used[2 * b] = used[2 * b + 1] = 0;
+      }
+      lookups = 0;
+      hits = 0;
+    }
+
+    size_t Lookups() const
+    {
+      return lookups.load(std::memory_order_relaxed);
+    }
+
+    size_t Hits() const
+    {
+      return hits.load(std::memory_order_relaxed);
+    }
+
+  protected:
+    std::unique_lock<std::mutex> Lock(size_t b)
+    {
+      if (!stripes)
+        return {};
+      return std::unique_lock<std::mutex>(stripes[b % stripe_count]);
+    }
+
+    void Swap(size_t e1, size_t e2)
+    {
+      std::swap(keys[e1], keys[e2]);
+      std::swap(used[e1], used[e2]);
+      std::swap_ranges(values.begin() + e1 * components, values.begin() + (e1 + 1) * components, values.begin() + e2 * components);
+    }
+
+    static constexpr size_t stripe_count = 64;
+    size_t components, buckets;
+    std::vector<std::uint64_t> keys;
+    // not a std::vector<bool>, whose bits would be shared among buckets guarded by different mutexes
+    std::vector<std::uint8_t> used;
+    std::vector<T> values;
+    std::unique_ptr<std::mutex[]> stripes;
+    std::atomic<size_t> lookups{ 0 }, hits{ 0 };
+  };
+}
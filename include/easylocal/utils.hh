@@ -15,6 +15,8 @@
 #include <experimental/coroutine>
 #endif
 #include <utility>   // std::forward, std::exchange
+#include <variant>
+#include <tuple>
 #include <concepts>
 
 #ifdef EXPERIMENTAL_COROUTINES